@@ -0,0 +1,17 @@
+# Benchmarks are built like the full tests, from a tests/bench/<name> folder
+# containing a bench.mk and config.h, plus the shared benchmark fixture.
+
+TEST_MK := bench.mk
+
+BENCH_SRC := \
+	tests/bench/common/bench_fixture.cpp
+
+VPATH += tests/bench/common
+
+# Count heap allocations made while replaying a trace
+LDFLAGS += \
+	-Wl,--wrap=malloc \
+	-Wl,--wrap=calloc \
+	-Wl,--wrap=realloc
+
+include builddefs/build_test.mk
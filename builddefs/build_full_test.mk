@@ -33,4 +33,5 @@ $(TEST)_DEFS := $(TMK_COMMON_DEFS) $(OPT_DEFS)
 
 $(TEST)_CONFIG := $(TEST_PATH)/config.h
 
-VPATH += $(TOP_DIR)/tests/test_common
+# Sources that include "config.h" pick up the config of the test
+VPATH += $(TOP_DIR)/tests/test_common $(TEST_PATH)
@@ -49,9 +49,11 @@ ifeq ($(strip $(DEBUG)), 1)
 CONSOLE_ENABLE = yes
 endif
 
+TEST_MK ?= test.mk
+
 ifneq ($(filter $(FULL_TESTS),$(TEST)),)
 include tests/test_common/build.mk
-include $(TEST_PATH)/test.mk
+include $(TEST_PATH)/$(TEST_MK)
 endif
 
 include $(BUILDDEFS_PATH)/common_features.mk
@@ -59,8 +61,10 @@ include $(BUILDDEFS_PATH)/generic_features.mk
 include $(PLATFORM_PATH)/common.mk
 include $(TMK_PATH)/protocol.mk
 include $(QUANTUM_PATH)/debounce/tests/rules.mk
+include $(QUANTUM_PATH)/dynamic_keymap/tests/rules.mk
 include $(QUANTUM_PATH)/encoder/tests/rules.mk
 include $(QUANTUM_PATH)/sequencer/tests/rules.mk
+include $(QUANTUM_PATH)/split_common/tests/rules.mk
 include $(PLATFORM_PATH)/test/rules.mk
 ifneq ($(filter $(FULL_TESTS),$(TEST)),)
 include $(BUILDDEFS_PATH)/build_full_test.mk
@@ -69,7 +73,8 @@ endif
 $(TEST)_SRC += \
 	tests/test_common/main.c \
 	$(LIB_PATH)/printf/printf.c \
-	$(QUANTUM_PATH)/logging/print.c
+	$(QUANTUM_PATH)/logging/print.c \
+	$(BENCH_SRC)
 
 $(TEST_OBJ)/$(TEST)_SRC := $($(TEST)_SRC)
 $(TEST_OBJ)/$(TEST)_INC := $($(TEST)_INC) $(VPATH) $(GTEST_INC)
@@ -625,9 +625,27 @@ ifeq ($(strip $(SPLIT_KEYBOARD)), yes)
     COMMON_VPATH += $(QUANTUM_PATH)/split_common
 endif
 
+VALID_CRC_DRIVER_TYPES := software hal
+
+CRC_DRIVER ?= software
 ifeq ($(strip $(CRC_ENABLE)), yes)
+    ifeq ($(filter $(CRC_DRIVER),$(VALID_CRC_DRIVER_TYPES)),)
+        $(call CATASTROPHIC_ERROR,Invalid CRC_DRIVER,CRC_DRIVER="$(CRC_DRIVER)" is not a valid CRC driver)
+    endif
+
     OPT_DEFS += -DCRC_ENABLE
     SRC += crc.c
+
+    ifeq ($(strip $(CRC_DRIVER)), hal)
+        OPT_DEFS += -DCRC_DRIVER_HAL
+        QUANTUM_LIB_SRC += crc_hal.c
+    endif
+endif
+
+ifeq ($(strip $(I2C_ASYNC_ENABLE)), yes)
+    OPT_DEFS += -DI2C_ASYNC_ENABLE
+    SRC += i2c_async.c
+    QUANTUM_LIB_SRC += i2c_master.c
 endif
 
 ifeq ($(strip $(HAPTIC_ENABLE)),yes)
@@ -27,6 +27,7 @@ GENERIC_FEATURES = \
     ENCODER \
     GRAVE_ESC \
     HAPTIC \
+    INPUT_LATENCY \
     KEY_LOCK \
     KEY_OVERRIDE \
     LEADER \
@@ -0,0 +1,117 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stddef.h>
+
+#include "i2c_async.h"
+
+// The transaction at the head of the queue is the one on the bus while in_flight is set
+static i2c_async_transaction_t *queue_head = NULL;
+static i2c_async_transaction_t *queue_tail = NULL;
+static bool                     in_flight  = false;
+
+static i2c_status_t default_status;
+
+i2c_status_t i2c_async_execute(const i2c_async_transaction_t *transaction) {
+    switch (transaction->op) {
+        case I2C_ASYNC_TRANSMIT:
+            return i2c_transmit(transaction->address, transaction->data, transaction->length, transaction->timeout);
+        case I2C_ASYNC_RECEIVE:
+            return i2c_receive(transaction->address, transaction->data, transaction->length, transaction->timeout);
+        case I2C_ASYNC_WRITE_REG:
+            return i2c_writeReg(transaction->address, transaction->reg, transaction->data, transaction->length, transaction->timeout);
+        case I2C_ASYNC_READ_REG:
+            return i2c_readReg(transaction->address, transaction->reg, transaction->data, transaction->length, transaction->timeout);
+        default:
+            return I2C_STATUS_ERROR;
+    }
+}
+
+__attribute__((weak)) void i2c_async_backend_start(i2c_async_transaction_t *transaction) {
+    default_status = i2c_async_execute(transaction);
+}
+
+__attribute__((weak)) bool i2c_async_backend_poll(i2c_status_t *status) {
+    *status = default_status;
+    return true;
+}
+
+static void start_next(void) {
+    if (queue_head) {
+        in_flight = true;
+        i2c_async_backend_start(queue_head);
+    }
+}
+
+bool i2c_async_submit(i2c_async_transaction_t *transaction) {
+    if (transaction->pending) {
+        return false;
+    }
+
+    transaction->pending = true;
+    transaction->status  = I2C_STATUS_SUCCESS;
+    transaction->next    = NULL;
+    if (queue_tail) {
+        queue_tail->next = transaction;
+    } else {
+        queue_head = transaction;
+    }
+    queue_tail = transaction;
+
+    if (!in_flight) {
+        start_next();
+    }
+    return true;
+}
+
+void i2c_async_task(void) {
+    i2c_status_t status;
+    while (in_flight && i2c_async_backend_poll(&status)) {
+        i2c_async_transaction_t *transaction = queue_head;
+
+        queue_head = transaction->next;
+        if (!queue_head) {
+            queue_tail = NULL;
+        }
+        in_flight = false;
+
+        transaction->status  = status;
+        transaction->pending = false;
+
+        // Keep the bus busy while the callback runs, it may queue more transactions anyway
+        start_next();
+        if (transaction->callback) {
+            transaction->callback(transaction);
+        }
+    }
+}
+
+bool i2c_async_idle(void) {
+    return queue_head == NULL;
+}
+
+i2c_status_t i2c_async_wait(i2c_async_transaction_t *transaction) {
+    while (transaction->pending) {
+        i2c_async_task();
+    }
+    return transaction->status;
+}
+
+void i2c_async_flush(void) {
+    while (!i2c_async_idle()) {
+        i2c_async_task();
+    }
+}
@@ -0,0 +1,83 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "i2c_master.h"
+
+/*
+ * Queue of I2C transactions that run in the background, so that the main
+ * loop doesn't have to wait for the bus. Transactions are owned by the caller
+ * and run in the order they were submitted. Once one has finished, its
+ * callback is called from i2c_async_task(), never from the background.
+ *
+ * Blocking i2c_master calls can still be made, but they may slip in between
+ * queued transactions. Call i2c_async_flush() first when that matters, e.g.
+ * when a device keeps state such as a selected page between transactions.
+ */
+
+typedef enum i2c_async_op_t {
+    I2C_ASYNC_TRANSMIT,  // i2c_transmit
+    I2C_ASYNC_RECEIVE,   // i2c_receive
+    I2C_ASYNC_WRITE_REG, // i2c_writeReg
+    I2C_ASYNC_READ_REG,  // i2c_readReg
+} i2c_async_op_t;
+
+typedef struct i2c_async_transaction_t i2c_async_transaction_t;
+typedef void (*i2c_async_callback_t)(i2c_async_transaction_t *transaction);
+
+struct i2c_async_transaction_t {
+    i2c_async_op_t       op;
+    uint8_t              address;  // already shifted, like the i2c_master functions
+    uint8_t              reg;      // only used by the _REG operations
+    uint8_t *            data;     // has to stay valid until the transaction has finished
+    uint16_t             length;
+    uint16_t             timeout;
+    i2c_async_callback_t callback; // optional
+    void *               context;  // for the callback's use
+
+    // Managed by the queue
+    volatile bool            pending;
+    volatile i2c_status_t    status;
+    i2c_async_transaction_t *next;
+};
+
+// Queues the transaction, returns false if it is still pending from an earlier submit.
+bool i2c_async_submit(i2c_async_transaction_t *transaction);
+// Hands out the results of finished transactions, and starts the next ones. Called from keyboard_task().
+void i2c_async_task(void);
+// Whether every submitted transaction has finished, and had its callback called.
+bool i2c_async_idle(void);
+// Waits for the transaction to finish, and returns its status.
+i2c_status_t i2c_async_wait(i2c_async_transaction_t *transaction);
+// Waits for every submitted transaction to finish.
+void i2c_async_flush(void);
+
+/*
+ * Platform backend. The default one runs each transaction with the blocking
+ * i2c_master functions as soon as it is started. ChibiOS runs them on a
+ * thread of their own instead, and the test platform on a simulated bus.
+ */
+
+// Runs the transaction with the blocking i2c_master functions.
+i2c_status_t i2c_async_execute(const i2c_async_transaction_t *transaction);
+// Starts the transaction, only one is started at a time.
+void i2c_async_backend_start(i2c_async_transaction_t *transaction);
+// Returns true once the started transaction has finished, with its outcome in status.
+bool i2c_async_backend_poll(i2c_status_t *status);
@@ -71,6 +71,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 uint8_t            st7565_buffer[ST7565_MATRIX_SIZE];
 uint8_t *          st7565_cursor;
 ST7565_BLOCK_TYPE  st7565_dirty       = 0;
+ST7565_BLOCK_TYPE  st7565_changed     = 0;
 bool               st7565_initialized = false;
 bool               st7565_active      = false;
 bool               st7565_inverted    = false;
@@ -142,10 +143,16 @@ __attribute__((weak)) display_rotation_t st7565_init_user(display_rotation_t rot
     return rotation;
 }
 
+// Blocks that need rendering, and separately, blocks whose contents changed for st7565_take_changed_blocks()
+static inline void st7565_mark_dirty(ST7565_BLOCK_TYPE blocks) {
+    st7565_dirty |= blocks;
+    st7565_changed |= blocks;
+}
+
 void st7565_clear(void) {
     memset(st7565_buffer, 0, sizeof(st7565_buffer));
     st7565_cursor = &st7565_buffer[0];
-    st7565_dirty  = ST7565_ALL_BLOCKS_MASK;
+    st7565_mark_dirty(ST7565_ALL_BLOCKS_MASK);
 }
 
 uint8_t crot(uint8_t a, int8_t n) {
@@ -282,9 +289,9 @@ void st7565_write_char(const char data, bool invert) {
     // Dirty check
     if (memcmp(&st7565_temp_buffer, st7565_cursor, ST7565_FONT_WIDTH)) {
         uint16_t index = st7565_cursor - &st7565_buffer[0];
-        st7565_dirty |= ((ST7565_BLOCK_TYPE)1 << (index / ST7565_BLOCK_SIZE));
+        st7565_mark_dirty((ST7565_BLOCK_TYPE)1 << (index / ST7565_BLOCK_SIZE));
         // Edgecase check if the written data spans the 2 chunks
-        st7565_dirty |= ((ST7565_BLOCK_TYPE)1 << ((index + ST7565_FONT_WIDTH - 1) / ST7565_BLOCK_SIZE));
+        st7565_mark_dirty((ST7565_BLOCK_TYPE)1 << ((index + ST7565_FONT_WIDTH - 1) / ST7565_BLOCK_SIZE));
     }
 
     // Finally move to the next char
@@ -319,7 +326,7 @@ void st7565_pan(bool left) {
             }
         }
     }
-    st7565_dirty = ST7565_ALL_BLOCKS_MASK;
+    st7565_mark_dirty(ST7565_ALL_BLOCKS_MASK);
 }
 
 display_buffer_reader_t st7565_read_raw(uint16_t start_index) {
@@ -330,11 +337,17 @@ display_buffer_reader_t st7565_read_raw(uint16_t start_index) {
     return ret_reader;
 }
 
+ST7565_BLOCK_TYPE st7565_take_changed_blocks(void) {
+    ST7565_BLOCK_TYPE changed = st7565_changed & ST7565_ALL_BLOCKS_MASK;
+    st7565_changed            = 0;
+    return changed;
+}
+
 void st7565_write_raw_byte(const char data, uint16_t index) {
     if (index > ST7565_MATRIX_SIZE) index = ST7565_MATRIX_SIZE;
     if (st7565_buffer[index] == data) return;
     st7565_buffer[index] = data;
-    st7565_dirty |= ((ST7565_BLOCK_TYPE)1 << (index / ST7565_BLOCK_SIZE));
+    st7565_mark_dirty((ST7565_BLOCK_TYPE)1 << (index / ST7565_BLOCK_SIZE));
 }
 
 void st7565_write_raw(const char *data, uint16_t size) {
@@ -344,7 +357,7 @@ void st7565_write_raw(const char *data, uint16_t size) {
         uint8_t c = *data++;
         if (st7565_buffer[i] == c) continue;
         st7565_buffer[i] = c;
-        st7565_dirty |= ((ST7565_BLOCK_TYPE)1 << (i / ST7565_BLOCK_SIZE));
+        st7565_mark_dirty((ST7565_BLOCK_TYPE)1 << (i / ST7565_BLOCK_SIZE));
     }
 }
 
@@ -364,7 +377,7 @@ void st7565_write_pixel(uint8_t x, uint8_t y, bool on) {
     }
     if (st7565_buffer[index] != data) {
         st7565_buffer[index] = data;
-        st7565_dirty |= ((ST7565_BLOCK_TYPE)1 << (index / ST7565_BLOCK_SIZE));
+        st7565_mark_dirty((ST7565_BLOCK_TYPE)1 << (index / ST7565_BLOCK_SIZE));
     }
 }
 
@@ -389,7 +402,7 @@ void st7565_write_raw_P(const char *data, uint16_t size) {
         uint8_t c = pgm_read_byte(data++);
         if (st7565_buffer[i] == c) continue;
         st7565_buffer[i] = c;
-        st7565_dirty |= ((ST7565_BLOCK_TYPE)1 << (i / ST7565_BLOCK_SIZE));
+        st7565_mark_dirty((ST7565_BLOCK_TYPE)1 << (i / ST7565_BLOCK_SIZE));
     }
 }
 #endif // defined(__AVR__)
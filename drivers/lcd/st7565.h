@@ -146,6 +146,10 @@ void st7565_pan(bool left);
 // buffer length as struct
 display_buffer_reader_t st7565_read_raw(uint16_t start_index);
 
+// Returns the blocks of the buffer written to since the last call, whether or not they
+// have been rendered yet, so that the contents can be mirrored elsewhere
+ST7565_BLOCK_TYPE st7565_take_changed_blocks(void);
+
 // Writes a string to the buffer at current cursor position
 void st7565_write_raw(const char *data, uint16_t size);
 
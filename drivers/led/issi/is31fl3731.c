@@ -68,6 +68,12 @@ uint8_t g_twi_transfer_buffer[20];
 uint8_t g_pwm_buffer[DRIVER_COUNT][144];
 bool    g_pwm_buffer_update_required[DRIVER_COUNT] = {false};
 
+// Each bit marks a 16 byte chunk of g_pwm_buffer that differs from the
+// device, so that only the chunks that changed are transmitted.
+#define ISSI_PWM_CHUNK_SIZE 16
+#define ISSI_PWM_CHUNKS_ALL 0x01FF
+uint16_t g_pwm_buffer_dirty_chunks[DRIVER_COUNT] = {0};
+
 uint8_t g_led_control_registers[DRIVER_COUNT][18]             = {{0}};
 bool    g_led_control_registers_update_required[DRIVER_COUNT] = {false};
 
@@ -98,31 +104,51 @@ void IS31FL3731_write_register(uint8_t addr, uint8_t reg, uint8_t data) {
 #endif
 }
 
-void IS31FL3731_write_pwm_buffer(uint8_t addr, uint8_t *pwm_buffer) {
+static bool IS31FL3731_write_pwm_chunks(uint8_t addr, uint8_t *pwm_buffer, uint16_t chunks) {
     // assumes bank is already selected
-
-    // transmit PWM registers in 9 transfers of 16 bytes
-    // g_twi_transfer_buffer[] is 20 bytes
-
-    // iterate over the pwm_buffer contents at 16 byte intervals
-    for (int i = 0; i < 144; i += 16) {
-        // set the first register, e.g. 0x24, 0x34, 0x44, etc.
-        g_twi_transfer_buffer[0] = 0x24 + i;
-        // copy the data from i to i+15
-        // device will auto-increment register for data after the first byte
-        // thus this sets registers 0x24-0x33, 0x34-0x43, etc. in one transfer
-        for (int j = 0; j < 16; j++) {
-            g_twi_transfer_buffer[1 + j] = pwm_buffer[i + j];
+    // returns false if any of the transfers failed
+
+    // device will auto-increment register for data after the first byte
+    // thus each run of neighbouring chunks is sent in one transfer
+    bool    success = true;
+    uint8_t chunk   = 0;
+    while (chunks) {
+        // skip to the start of the next run, then measure its length
+        while (!(chunks & 1)) {
+            chunks >>= 1;
+            chunk++;
+        }
+        uint8_t run = 0;
+        while (chunks & 1) {
+            chunks >>= 1;
+            run++;
         }
 
+        uint8_t offset = chunk * ISSI_PWM_CHUNK_SIZE;
+        uint8_t length = run * ISSI_PWM_CHUNK_SIZE;
 #if ISSI_PERSISTENCE > 0
-        for (uint8_t i = 0; i < ISSI_PERSISTENCE; i++) {
-            if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 17, ISSI_TIMEOUT) == 0) break;
+        uint8_t i = 0;
+        for (; i < ISSI_PERSISTENCE; i++) {
+            if (i2c_writeReg(addr << 1, 0x24 + offset, pwm_buffer + offset, length, ISSI_TIMEOUT) == 0) break;
+        }
+        if (i == ISSI_PERSISTENCE) {
+            success = false;
         }
 #else
-        i2c_transmit(addr << 1, g_twi_transfer_buffer, 17, ISSI_TIMEOUT);
+        if (i2c_writeReg(addr << 1, 0x24 + offset, pwm_buffer + offset, length, ISSI_TIMEOUT) != 0) {
+            success = false;
+        }
 #endif
+        chunk += run;
     }
+    return success;
+}
+
+void IS31FL3731_write_pwm_buffer(uint8_t addr, uint8_t *pwm_buffer) {
+    // assumes bank is already selected
+
+    // transmit all 144 PWM registers in one transfer
+    IS31FL3731_write_pwm_chunks(addr, pwm_buffer, ISSI_PWM_CHUNKS_ALL);
 }
 
 void IS31FL3731_init(uint8_t addr) {
@@ -167,6 +193,11 @@ void IS31FL3731_init(uint8_t addr) {
     for (int i = 0x24; i <= 0xB3; i++) {
         IS31FL3731_write_register(addr, i, 0x00);
     }
+    // and make sure the next update rewrites them from the buffers
+    for (int i = 0; i < DRIVER_COUNT; i++) {
+        g_pwm_buffer_dirty_chunks[i]    = ISSI_PWM_CHUNKS_ALL;
+        g_pwm_buffer_update_required[i] = true;
+    }
 
     // select "function register" bank
     IS31FL3731_write_register(addr, ISSI_COMMANDREGISTER, ISSI_BANK_FUNCTIONREG);
@@ -180,16 +211,23 @@ void IS31FL3731_init(uint8_t addr) {
     IS31FL3731_write_register(addr, ISSI_COMMANDREGISTER, 0);
 }
 
+static void IS31FL3731_set_pwm(uint8_t driver, uint8_t offset, uint8_t value) {
+    if (g_pwm_buffer[driver][offset] != value) {
+        g_pwm_buffer[driver][offset]         = value;
+        g_pwm_buffer_dirty_chunks[driver]   |= 1 << (offset / ISSI_PWM_CHUNK_SIZE);
+        g_pwm_buffer_update_required[driver] = true;
+    }
+}
+
 void IS31FL3731_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
     is31_led led;
     if (index >= 0 && index < DRIVER_LED_TOTAL) {
         memcpy_P(&led, (&g_is31_leds[index]), sizeof(led));
 
         // Subtract 0x24 to get the second index of g_pwm_buffer
-        g_pwm_buffer[led.driver][led.r - 0x24]   = red;
-        g_pwm_buffer[led.driver][led.g - 0x24]   = green;
-        g_pwm_buffer[led.driver][led.b - 0x24]   = blue;
-        g_pwm_buffer_update_required[led.driver] = true;
+        IS31FL3731_set_pwm(led.driver, led.r - 0x24, red);
+        IS31FL3731_set_pwm(led.driver, led.g - 0x24, green);
+        IS31FL3731_set_pwm(led.driver, led.b - 0x24, blue);
     }
 }
 
@@ -231,7 +269,15 @@ void IS31FL3731_set_led_control_register(uint8_t index, bool red, bool green, bo
 
 void IS31FL3731_update_pwm_buffers(uint8_t addr, uint8_t index) {
     if (g_pwm_buffer_update_required[index]) {
-        IS31FL3731_write_pwm_buffer(addr, g_pwm_buffer[index]);
+        // the flag without any dirty chunks means the buffer was changed directly
+        uint16_t chunks = g_pwm_buffer_dirty_chunks[index] ? g_pwm_buffer_dirty_chunks[index] : ISSI_PWM_CHUNKS_ALL;
+
+        // if a transfer fails the PWM registers are in an unknown state,
+        // so the next update has to resend all of them
+        g_pwm_buffer_dirty_chunks[index] = 0;
+        if (!IS31FL3731_write_pwm_chunks(addr, g_pwm_buffer[index], chunks)) {
+            g_pwm_buffer_dirty_chunks[index] = ISSI_PWM_CHUNKS_ALL;
+        }
     }
     g_pwm_buffer_update_required[index] = false;
 }
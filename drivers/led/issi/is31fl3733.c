@@ -20,6 +20,9 @@
 #include "is31fl3733.h"
 #include "i2c_master.h"
 #include "wait.h"
+#if defined(I2C_ASYNC_ENABLE)
+#    include "i2c_async.h"
+#endif
 
 // This is a 7-bit address, that gets left-shifted and bit 0
 // set to 0 for write, 1 for read (as per I2C protocol)
@@ -81,11 +84,91 @@ uint8_t g_twi_transfer_buffer[20];
 uint8_t g_pwm_buffer[DRIVER_COUNT][192];
 bool    g_pwm_buffer_update_required[DRIVER_COUNT] = {false};
 
+// Each bit marks a 16 byte chunk of g_pwm_buffer that differs from the
+// device, so that only the chunks that changed are transmitted.
+#define ISSI_PWM_CHUNK_SIZE 16
+#define ISSI_PWM_CHUNKS_ALL 0x0FFF
+uint16_t g_pwm_buffer_dirty_chunks[DRIVER_COUNT] = {0};
+
 uint8_t g_led_control_registers[DRIVER_COUNT][24]             = {0};
 bool    g_led_control_registers_update_required[DRIVER_COUNT] = {false};
 
+#if defined(I2C_ASYNC_ENABLE)
+// The PWM updates are queued: unlock, select PG1, then at most 6 runs of
+// dirty chunks, as every other one of the 12 chunks can be clean.
+#    define ISSI_PWM_RUNS_MAX 6
+#    define ISSI_PWM_TRANSACTIONS (2 + ISSI_PWM_RUNS_MAX)
+
+static uint8_t                 g_unlock_data   = 0xC5;
+static uint8_t                 g_page_pwm_data = ISSI_PAGE_PWM;
+static i2c_async_transaction_t g_pwm_transactions[DRIVER_COUNT][ISSI_PWM_TRANSACTIONS];
+
+static void IS31FL3733_pwm_transaction_done(i2c_async_transaction_t *transaction) {
+    // Same recovery as the blocking update, PG0 may have been written
+    // and the PWM registers are in an unknown state.
+    if (transaction->status != I2C_STATUS_SUCCESS) {
+        uint8_t index                                  = (uintptr_t)transaction->context;
+        g_led_control_registers_update_required[index] = true;
+        g_pwm_buffer_dirty_chunks[index]               = ISSI_PWM_CHUNKS_ALL;
+        g_pwm_buffer_update_required[index]            = true;
+    }
+}
+
+static bool IS31FL3733_pwm_transactions_pending(uint8_t index) {
+    for (uint8_t i = 0; i < ISSI_PWM_TRANSACTIONS; i++) {
+        if (g_pwm_transactions[index][i].pending) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void IS31FL3733_queue_transaction(uint8_t addr, uint8_t index, uint8_t slot, uint8_t reg, uint8_t *data, uint8_t length) {
+    i2c_async_transaction_t *transaction = &g_pwm_transactions[index][slot];
+
+    transaction->op       = I2C_ASYNC_WRITE_REG;
+    transaction->address  = addr << 1;
+    transaction->reg      = reg;
+    transaction->data     = data;
+    transaction->length   = length;
+    transaction->timeout  = ISSI_TIMEOUT;
+    transaction->callback = IS31FL3733_pwm_transaction_done;
+    transaction->context  = (void *)(uintptr_t)index;
+    i2c_async_submit(transaction);
+}
+
+static void IS31FL3733_queue_pwm_chunks(uint8_t addr, uint8_t index, uint16_t chunks) {
+    // Chunks that change while they are being sent are marked dirty again,
+    // so the registers are sent straight from g_pwm_buffer.
+    IS31FL3733_queue_transaction(addr, index, 0, ISSI_COMMANDREGISTER_WRITELOCK, &g_unlock_data, 1);
+    IS31FL3733_queue_transaction(addr, index, 1, ISSI_COMMANDREGISTER, &g_page_pwm_data, 1);
+
+    uint8_t chunk = 0;
+    uint8_t slot  = 2;
+    while (chunks) {
+        while (!(chunks & 1)) {
+            chunks >>= 1;
+            chunk++;
+        }
+        uint8_t run = 0;
+        while (chunks & 1) {
+            chunks >>= 1;
+            run++;
+        }
+
+        uint8_t reg = chunk * ISSI_PWM_CHUNK_SIZE;
+        IS31FL3733_queue_transaction(addr, index, slot++, reg, g_pwm_buffer[index] + reg, run * ISSI_PWM_CHUNK_SIZE);
+        chunk += run;
+    }
+}
+#endif
+
 bool IS31FL3733_write_register(uint8_t addr, uint8_t reg, uint8_t data) {
     // If the transaction fails function returns false.
+#if defined(I2C_ASYNC_ENABLE)
+    // The queued PWM updates rely on the page they selected.
+    i2c_async_flush();
+#endif
     g_twi_transfer_buffer[0] = reg;
     g_twi_transfer_buffer[1] = data;
 
@@ -103,37 +186,49 @@ bool IS31FL3733_write_register(uint8_t addr, uint8_t reg, uint8_t data) {
     return true;
 }
 
-bool IS31FL3733_write_pwm_buffer(uint8_t addr, uint8_t *pwm_buffer) {
+static bool IS31FL3733_write_pwm_chunks(uint8_t addr, uint8_t *pwm_buffer, uint16_t chunks) {
     // Assumes PG1 is already selected.
     // If any of the transactions fails function returns false.
-    // Transmit PWM registers in 12 transfers of 16 bytes.
-    // g_twi_transfer_buffer[] is 20 bytes
-
-    // Iterate over the pwm_buffer contents at 16 byte intervals.
-    for (int i = 0; i < 192; i += 16) {
-        g_twi_transfer_buffer[0] = i;
-        // Copy the data from i to i+15.
-        // Device will auto-increment register for data after the first byte
-        // Thus this sets registers 0x00-0x0F, 0x10-0x1F, etc. in one transfer.
-        for (int j = 0; j < 16; j++) {
-            g_twi_transfer_buffer[1 + j] = pwm_buffer[i + j];
+    // Device will auto-increment register for data after the first byte,
+    // thus each run of neighbouring chunks is sent in one transfer.
+    uint8_t chunk = 0;
+    while (chunks) {
+        // Skip to the start of the next run, then measure its length.
+        while (!(chunks & 1)) {
+            chunks >>= 1;
+            chunk++;
+        }
+        uint8_t run = 0;
+        while (chunks & 1) {
+            chunks >>= 1;
+            run++;
         }
 
+        uint8_t reg    = chunk * ISSI_PWM_CHUNK_SIZE;
+        uint8_t length = run * ISSI_PWM_CHUNK_SIZE;
 #if ISSI_PERSISTENCE > 0
         for (uint8_t i = 0; i < ISSI_PERSISTENCE; i++) {
-            if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 17, ISSI_TIMEOUT) != 0) {
+            if (i2c_writeReg(addr << 1, reg, pwm_buffer + reg, length, ISSI_TIMEOUT) != 0) {
                 return false;
             }
         }
 #else
-        if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 17, ISSI_TIMEOUT) != 0) {
+        if (i2c_writeReg(addr << 1, reg, pwm_buffer + reg, length, ISSI_TIMEOUT) != 0) {
             return false;
         }
 #endif
+        chunk += run;
     }
     return true;
 }
 
+bool IS31FL3733_write_pwm_buffer(uint8_t addr, uint8_t *pwm_buffer) {
+    // Assumes PG1 is already selected.
+    // If the transaction fails function returns false.
+    // Transmit all 192 PWM registers in one transfer.
+    return IS31FL3733_write_pwm_chunks(addr, pwm_buffer, ISSI_PWM_CHUNKS_ALL);
+}
+
 void IS31FL3733_init(uint8_t addr, uint8_t sync) {
     // In order to avoid the LEDs being driven with garbage data
     // in the LED driver's PWM registers, shutdown is enabled last.
@@ -176,19 +271,33 @@ void IS31FL3733_init(uint8_t addr, uint8_t sync) {
     // Disable software shutdown.
     IS31FL3733_write_register(addr, ISSI_REG_CONFIGURATION, ((sync & 0b11) << 6) | ((ISSI_PWM_FREQUENCY & 0b111) << 3) | 0x01);
 
+    // The PWM registers were just cleared, make sure the next update
+    // rewrites them from the buffers.
+    for (int i = 0; i < DRIVER_COUNT; i++) {
+        g_pwm_buffer_dirty_chunks[i]    = ISSI_PWM_CHUNKS_ALL;
+        g_pwm_buffer_update_required[i] = true;
+    }
+
     // Wait 10ms to ensure the device has woken up.
     wait_ms(10);
 }
 
+static void IS31FL3733_set_pwm(uint8_t driver, uint8_t reg, uint8_t value) {
+    if (g_pwm_buffer[driver][reg] != value) {
+        g_pwm_buffer[driver][reg]            = value;
+        g_pwm_buffer_dirty_chunks[driver]   |= 1 << (reg / ISSI_PWM_CHUNK_SIZE);
+        g_pwm_buffer_update_required[driver] = true;
+    }
+}
+
 void IS31FL3733_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
     is31_led led;
     if (index >= 0 && index < DRIVER_LED_TOTAL) {
         memcpy_P(&led, (&g_is31_leds[index]), sizeof(led));
 
-        g_pwm_buffer[led.driver][led.r]          = red;
-        g_pwm_buffer[led.driver][led.g]          = green;
-        g_pwm_buffer[led.driver][led.b]          = blue;
-        g_pwm_buffer_update_required[led.driver] = true;
+        IS31FL3733_set_pwm(led.driver, led.r, red);
+        IS31FL3733_set_pwm(led.driver, led.g, green);
+        IS31FL3733_set_pwm(led.driver, led.b, blue);
     }
 }
 
@@ -229,16 +338,33 @@ void IS31FL3733_set_led_control_register(uint8_t index, bool red, bool green, bo
 }
 
 void IS31FL3733_update_pwm_buffers(uint8_t addr, uint8_t index) {
+#if defined(I2C_ASYNC_ENABLE)
+    // Keep the update for a later call while the previous one is still queued.
+    if (IS31FL3733_pwm_transactions_pending(index)) {
+        return;
+    }
+#endif
     if (g_pwm_buffer_update_required[index]) {
+        // The flag without any dirty chunks means the buffer was changed directly.
+        uint16_t chunks = g_pwm_buffer_dirty_chunks[index] ? g_pwm_buffer_dirty_chunks[index] : ISSI_PWM_CHUNKS_ALL;
+
+#if defined(I2C_ASYNC_ENABLE)
+        g_pwm_buffer_dirty_chunks[index] = 0;
+        IS31FL3733_queue_pwm_chunks(addr, index, chunks);
+#else
         // Firstly we need to unlock the command register and select PG1.
         IS31FL3733_write_register(addr, ISSI_COMMANDREGISTER_WRITELOCK, 0xC5);
         IS31FL3733_write_register(addr, ISSI_COMMANDREGISTER, ISSI_PAGE_PWM);
 
         // If any of the transactions fail we risk writing dirty PG0,
-        // refresh page 0 just in case.
-        if (!IS31FL3733_write_pwm_buffer(addr, g_pwm_buffer[index])) {
+        // refresh page 0 just in case. The PWM registers are then in an
+        // unknown state, so the next update has to resend all of them.
+        g_pwm_buffer_dirty_chunks[index] = 0;
+        if (!IS31FL3733_write_pwm_chunks(addr, g_pwm_buffer[index], chunks)) {
             g_led_control_registers_update_required[index] = true;
+            g_pwm_buffer_dirty_chunks[index]               = ISSI_PWM_CHUNKS_ALL;
         }
+#endif
     }
     g_pwm_buffer_update_required[index] = false;
 }
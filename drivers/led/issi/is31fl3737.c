@@ -78,6 +78,12 @@ uint8_t g_twi_transfer_buffer[20];
 uint8_t g_pwm_buffer[DRIVER_COUNT][192];
 bool    g_pwm_buffer_update_required[DRIVER_COUNT] = {false};
 
+// Each bit marks a 16 byte chunk of g_pwm_buffer that differs from the
+// device, so that only the chunks that changed are transmitted.
+#define ISSI_PWM_CHUNK_SIZE 16
+#define ISSI_PWM_CHUNKS_ALL 0x0FFF
+uint16_t g_pwm_buffer_dirty_chunks[DRIVER_COUNT] = {0};
+
 uint8_t g_led_control_registers[DRIVER_COUNT][24]             = {0};
 bool    g_led_control_registers_update_required[DRIVER_COUNT] = {false};
 
@@ -94,30 +100,51 @@ void IS31FL3737_write_register(uint8_t addr, uint8_t reg, uint8_t data) {
 #endif
 }
 
-void IS31FL3737_write_pwm_buffer(uint8_t addr, uint8_t *pwm_buffer) {
+static bool IS31FL3737_write_pwm_chunks(uint8_t addr, uint8_t *pwm_buffer, uint16_t chunks) {
     // assumes PG1 is already selected
-
-    // transmit PWM registers in 12 transfers of 16 bytes
-    // g_twi_transfer_buffer[] is 20 bytes
-
-    // iterate over the pwm_buffer contents at 16 byte intervals
-    for (int i = 0; i < 192; i += 16) {
-        g_twi_transfer_buffer[0] = i;
-        // copy the data from i to i+15
-        // device will auto-increment register for data after the first byte
-        // thus this sets registers 0x00-0x0F, 0x10-0x1F, etc. in one transfer
-        for (int j = 0; j < 16; j++) {
-            g_twi_transfer_buffer[1 + j] = pwm_buffer[i + j];
+    // returns false if any of the transfers failed
+
+    // device will auto-increment register for data after the first byte
+    // thus each run of neighbouring chunks is sent in one transfer
+    bool    success = true;
+    uint8_t chunk   = 0;
+    while (chunks) {
+        // skip to the start of the next run, then measure its length
+        while (!(chunks & 1)) {
+            chunks >>= 1;
+            chunk++;
+        }
+        uint8_t run = 0;
+        while (chunks & 1) {
+            chunks >>= 1;
+            run++;
         }
 
+        uint8_t reg    = chunk * ISSI_PWM_CHUNK_SIZE;
+        uint8_t length = run * ISSI_PWM_CHUNK_SIZE;
 #if ISSI_PERSISTENCE > 0
-        for (uint8_t i = 0; i < ISSI_PERSISTENCE; i++) {
-            if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 17, ISSI_TIMEOUT) == 0) break;
+        uint8_t i = 0;
+        for (; i < ISSI_PERSISTENCE; i++) {
+            if (i2c_writeReg(addr << 1, reg, pwm_buffer + reg, length, ISSI_TIMEOUT) == 0) break;
+        }
+        if (i == ISSI_PERSISTENCE) {
+            success = false;
         }
 #else
-        i2c_transmit(addr << 1, g_twi_transfer_buffer, 17, ISSI_TIMEOUT);
+        if (i2c_writeReg(addr << 1, reg, pwm_buffer + reg, length, ISSI_TIMEOUT) != 0) {
+            success = false;
+        }
 #endif
+        chunk += run;
     }
+    return success;
+}
+
+void IS31FL3737_write_pwm_buffer(uint8_t addr, uint8_t *pwm_buffer) {
+    // assumes PG1 is already selected
+
+    // transmit all 192 PWM registers in one transfer
+    IS31FL3737_write_pwm_chunks(addr, pwm_buffer, ISSI_PWM_CHUNKS_ALL);
 }
 
 void IS31FL3737_init(uint8_t addr) {
@@ -161,19 +188,33 @@ void IS31FL3737_init(uint8_t addr) {
     // Disable software shutdown.
     IS31FL3737_write_register(addr, ISSI_REG_CONFIGURATION, 0x01);
 
+    // The PWM registers were just cleared, make sure the next update
+    // rewrites them from the buffers.
+    for (int i = 0; i < DRIVER_COUNT; i++) {
+        g_pwm_buffer_dirty_chunks[i]    = ISSI_PWM_CHUNKS_ALL;
+        g_pwm_buffer_update_required[i] = true;
+    }
+
     // Wait 10ms to ensure the device has woken up.
     wait_ms(10);
 }
 
+static void IS31FL3737_set_pwm(uint8_t driver, uint8_t reg, uint8_t value) {
+    if (g_pwm_buffer[driver][reg] != value) {
+        g_pwm_buffer[driver][reg]            = value;
+        g_pwm_buffer_dirty_chunks[driver]   |= 1 << (reg / ISSI_PWM_CHUNK_SIZE);
+        g_pwm_buffer_update_required[driver] = true;
+    }
+}
+
 void IS31FL3737_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
     is31_led led;
     if (index >= 0 && index < DRIVER_LED_TOTAL) {
         memcpy_P(&led, (&g_is31_leds[index]), sizeof(led));
 
-        g_pwm_buffer[led.driver][led.r]          = red;
-        g_pwm_buffer[led.driver][led.g]          = green;
-        g_pwm_buffer[led.driver][led.b]          = blue;
-        g_pwm_buffer_update_required[led.driver] = true;
+        IS31FL3737_set_pwm(led.driver, led.r, red);
+        IS31FL3737_set_pwm(led.driver, led.g, green);
+        IS31FL3737_set_pwm(led.driver, led.b, blue);
     }
 }
 
@@ -215,11 +256,19 @@ void IS31FL3737_set_led_control_register(uint8_t index, bool red, bool green, bo
 
 void IS31FL3737_update_pwm_buffers(uint8_t addr, uint8_t index) {
     if (g_pwm_buffer_update_required[index]) {
+        // The flag without any dirty chunks means the buffer was changed directly
+        uint16_t chunks = g_pwm_buffer_dirty_chunks[index] ? g_pwm_buffer_dirty_chunks[index] : ISSI_PWM_CHUNKS_ALL;
+
         // Firstly we need to unlock the command register and select PG1
         IS31FL3737_write_register(addr, ISSI_COMMANDREGISTER_WRITELOCK, 0xC5);
         IS31FL3737_write_register(addr, ISSI_COMMANDREGISTER, ISSI_PAGE_PWM);
 
-        IS31FL3737_write_pwm_buffer(addr, g_pwm_buffer[index]);
+        // If a transfer fails the PWM registers are in an unknown state,
+        // so the next update has to resend all of them
+        g_pwm_buffer_dirty_chunks[index] = 0;
+        if (!IS31FL3737_write_pwm_chunks(addr, g_pwm_buffer[index], chunks)) {
+            g_pwm_buffer_dirty_chunks[index] = ISSI_PWM_CHUNKS_ALL;
+        }
     }
     g_pwm_buffer_update_required[index] = false;
 }
@@ -86,6 +86,15 @@ bool    g_scaling_registers_update_required[DRIVER_COUNT] = {false};
 
 uint8_t g_scaling_registers[DRIVER_COUNT][ISSI_MAX_LEDS];
 
+// Each bit marks an 18 byte chunk of g_pwm_buffer that differs from the
+// device, so that only the chunks that changed are transmitted. The first
+// ten chunks live in PG0 and the rest in PG1, the last one is 9 bytes long.
+#define ISSI_PWM_CHUNK_SIZE 18
+#define ISSI_PWM_PAGE_SIZE 180
+#define ISSI_PWM_PAGE_CHUNKS (ISSI_PWM_PAGE_SIZE / ISSI_PWM_CHUNK_SIZE)
+#define ISSI_PWM_CHUNKS_ALL 0x000FFFFF
+uint32_t g_pwm_buffer_dirty_chunks[DRIVER_COUNT] = {0};
+
 void IS31FL3741_write_register(uint8_t addr, uint8_t reg, uint8_t data) {
     g_twi_transfer_buffer[0] = reg;
     g_twi_transfer_buffer[1] = data;
@@ -99,53 +108,62 @@ void IS31FL3741_write_register(uint8_t addr, uint8_t reg, uint8_t data) {
 #endif
 }
 
-bool IS31FL3741_write_pwm_buffer(uint8_t addr, uint8_t *pwm_buffer) {
-    // unlock the command register and select PG2
-    IS31FL3741_write_register(addr, ISSI_COMMANDREGISTER_WRITELOCK, 0xC5);
-    IS31FL3741_write_register(addr, ISSI_COMMANDREGISTER, ISSI_PAGE_PWM0);
-
-    for (int i = 0; i < 342; i += 18) {
-        if (i == 180) {
-            // unlock the command register and select PG2
-            IS31FL3741_write_register(addr, ISSI_COMMANDREGISTER_WRITELOCK, 0xC5);
-            IS31FL3741_write_register(addr, ISSI_COMMANDREGISTER, ISSI_PAGE_PWM1);
+static bool IS31FL3741_write_pwm_chunks(uint8_t addr, uint8_t *pwm_buffer, uint32_t chunks) {
+    for (uint8_t page = 0; page < 2; page++) {
+        uint16_t page_chunks = (chunks >> (page * ISSI_PWM_PAGE_CHUNKS)) & ((1 << ISSI_PWM_PAGE_CHUNKS) - 1);
+        uint8_t  page_size   = page ? ISSI_MAX_LEDS - ISSI_PWM_PAGE_SIZE : ISSI_PWM_PAGE_SIZE;
+        if (!page_chunks) {
+            continue;
         }
 
-        g_twi_transfer_buffer[0] = i % 180;
-        memcpy(g_twi_transfer_buffer + 1, pwm_buffer + i, 18);
+        // unlock the command register and select PG0 or PG1
+        IS31FL3741_write_register(addr, ISSI_COMMANDREGISTER_WRITELOCK, 0xC5);
+        IS31FL3741_write_register(addr, ISSI_COMMANDREGISTER, page ? ISSI_PAGE_PWM1 : ISSI_PAGE_PWM0);
+
+        // the device auto-increments the register address after each byte,
+        // so each run of neighbouring chunks is sent in one transfer
+        uint8_t chunk = 0;
+        while (page_chunks) {
+            while (!(page_chunks & 1)) {
+                page_chunks >>= 1;
+                chunk++;
+            }
+            uint8_t run = 0;
+            while (page_chunks & 1) {
+                page_chunks >>= 1;
+                run++;
+            }
+
+            uint8_t  reg    = chunk * ISSI_PWM_CHUNK_SIZE;
+            uint8_t  length = run * ISSI_PWM_CHUNK_SIZE;
+            uint8_t *data   = pwm_buffer + page * ISSI_PWM_PAGE_SIZE + reg;
+            if (length > page_size - reg) {
+                // the last chunk of PG1 is only half used
+                length = page_size - reg;
+            }
 
 #if ISSI_PERSISTENCE > 0
-        for (uint8_t i = 0; i < ISSI_PERSISTENCE; i++) {
-            if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 19, ISSI_TIMEOUT) != 0) {
-                return false;
+            for (uint8_t i = 0; i < ISSI_PERSISTENCE; i++) {
+                if (i2c_writeReg(addr << 1, reg, data, length, ISSI_TIMEOUT) != 0) {
+                    return false;
+                }
             }
-        }
 #else
-        if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 19, ISSI_TIMEOUT) != 0) {
-            return false;
-        }
+            if (i2c_writeReg(addr << 1, reg, data, length, ISSI_TIMEOUT) != 0) {
+                return false;
+            }
 #endif
-    }
-
-    // transfer the left cause the total number is 351
-    g_twi_transfer_buffer[0] = 162;
-    memcpy(g_twi_transfer_buffer + 1, pwm_buffer + 342, 9);
-
-#if ISSI_PERSISTENCE > 0
-    for (uint8_t i = 0; i < ISSI_PERSISTENCE; i++) {
-        if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 10, ISSI_TIMEOUT) != 0) {
-            return false;
+            chunk += run;
         }
     }
-#else
-    if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 10, ISSI_TIMEOUT) != 0) {
-        return false;
-    }
-#endif
 
     return true;
 }
 
+bool IS31FL3741_write_pwm_buffer(uint8_t addr, uint8_t *pwm_buffer) {
+    return IS31FL3741_write_pwm_chunks(addr, pwm_buffer, ISSI_PWM_CHUNKS_ALL);
+}
+
 void IS31FL3741_init(uint8_t addr) {
     // In order to avoid the LEDs being driven with garbage data
     // in the LED driver's PWM registers, shutdown is enabled last.
@@ -169,19 +187,32 @@ void IS31FL3741_init(uint8_t addr) {
 
     // IS31FL3741_update_led_scaling_registers(addr, 0xFF, 0xFF, 0xFF);
 
+    // Make sure the next update writes all of the PWM registers.
+    for (int i = 0; i < DRIVER_COUNT; i++) {
+        g_pwm_buffer_dirty_chunks[i]    = ISSI_PWM_CHUNKS_ALL;
+        g_pwm_buffer_update_required[i] = true;
+    }
+
     // Wait 10ms to ensure the device has woken up.
     wait_ms(10);
 }
 
+static void IS31FL3741_set_pwm(uint8_t driver, uint16_t reg, uint8_t value) {
+    if (g_pwm_buffer[driver][reg] != value) {
+        g_pwm_buffer[driver][reg]            = value;
+        g_pwm_buffer_dirty_chunks[driver]   |= (uint32_t)1 << (reg / ISSI_PWM_CHUNK_SIZE);
+        g_pwm_buffer_update_required[driver] = true;
+    }
+}
+
 void IS31FL3741_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
     is31_led led;
     if (index >= 0 && index < DRIVER_LED_TOTAL) {
         memcpy_P(&led, (&g_is31_leds[index]), sizeof(led));
 
-        g_pwm_buffer[led.driver][led.r]          = red;
-        g_pwm_buffer[led.driver][led.g]          = green;
-        g_pwm_buffer[led.driver][led.b]          = blue;
-        g_pwm_buffer_update_required[led.driver] = true;
+        IS31FL3741_set_pwm(led.driver, led.r, red);
+        IS31FL3741_set_pwm(led.driver, led.g, green);
+        IS31FL3741_set_pwm(led.driver, led.b, blue);
     }
 }
 
@@ -218,18 +249,24 @@ void IS31FL3741_set_led_control_register(uint8_t index, bool red, bool green, bo
 
 void IS31FL3741_update_pwm_buffers(uint8_t addr, uint8_t index) {
     if (g_pwm_buffer_update_required[index]) {
-        IS31FL3741_write_pwm_buffer(addr, g_pwm_buffer[index]);
+        // The flag without any dirty chunks means the buffer was changed directly.
+        uint32_t chunks = g_pwm_buffer_dirty_chunks[index] ? g_pwm_buffer_dirty_chunks[index] : ISSI_PWM_CHUNKS_ALL;
+
+        // If a transfer fails the PWM registers are in an unknown state,
+        // so the next update has to resend all of them.
+        g_pwm_buffer_dirty_chunks[index] = 0;
+        if (!IS31FL3741_write_pwm_chunks(addr, g_pwm_buffer[index], chunks)) {
+            g_pwm_buffer_dirty_chunks[index] = ISSI_PWM_CHUNKS_ALL;
+        }
     }
 
     g_pwm_buffer_update_required[index] = false;
 }
 
 void IS31FL3741_set_pwm_buffer(const is31_led *pled, uint8_t red, uint8_t green, uint8_t blue) {
-    g_pwm_buffer[pled->driver][pled->r] = red;
-    g_pwm_buffer[pled->driver][pled->g] = green;
-    g_pwm_buffer[pled->driver][pled->b] = blue;
-
-    g_pwm_buffer_update_required[pled->driver] = true;
+    IS31FL3741_set_pwm(pled->driver, pled->r, red);
+    IS31FL3741_set_pwm(pled->driver, pled->g, green);
+    IS31FL3741_set_pwm(pled->driver, pled->b, blue);
 }
 
 void IS31FL3741_update_led_control_registers(uint8_t addr, uint8_t index) {
@@ -39,6 +39,12 @@ uint8_t g_twi_transfer_buffer[20];
 uint8_t g_pwm_buffer[DRIVER_COUNT][ISSI_MAX_LEDS];
 bool    g_pwm_buffer_update_required[DRIVER_COUNT] = {false};
 
+// Each bit marks a chunk of ISSI_PWM_TRF_SIZE bytes of g_pwm_buffer that
+// differs from the device, so that only the chunks that changed are sent.
+#define ISSI_PWM_CHUNKS ((ISSI_MAX_LEDS + ISSI_PWM_TRF_SIZE - 1) / ISSI_PWM_TRF_SIZE)
+#define ISSI_PWM_CHUNKS_ALL ((1 << ISSI_PWM_CHUNKS) - 1)
+uint16_t g_pwm_buffer_dirty_chunks[DRIVER_COUNT] = {0};
+
 uint8_t g_scaling_buffer[DRIVER_COUNT][ISSI_SCALING_SIZE];
 bool    g_scaling_buffer_update_required[DRIVER_COUNT] = {false};
 
@@ -83,6 +89,47 @@ bool IS31FL_write_multi_registers(uint8_t addr, uint8_t *source_buffer, uint8_t
     return true;
 }
 
+// Same as IS31FL_write_multi_registers, but only for the PWM chunks flagged in chunks,
+// and with each run of neighbouring chunks merged into a single transfer.
+static bool IS31FL_write_pwm_chunks(uint8_t addr, uint8_t *source_buffer, uint16_t chunks) {
+    bool    success = true;
+    uint8_t chunk   = 0;
+    while (chunks) {
+        // Skip to the start of the next run, then measure its length
+        while (!(chunks & 1)) {
+            chunks >>= 1;
+            chunk++;
+        }
+        uint8_t run = 0;
+        while (chunks & 1) {
+            chunks >>= 1;
+            run++;
+        }
+
+        uint8_t offset = chunk * ISSI_PWM_TRF_SIZE;
+        uint8_t length = run * ISSI_PWM_TRF_SIZE;
+        if (length > ISSI_MAX_LEDS - offset) {
+            length = ISSI_MAX_LEDS - offset;
+        }
+
+#if ISSI_PERSISTENCE > 0
+        uint8_t i = 0;
+        for (; i < ISSI_PERSISTENCE; i++) {
+            if (i2c_writeReg(addr << 1, offset + ISSI_PWM_REG_1ST, source_buffer + offset, length, ISSI_TIMEOUT) == 0) break;
+        }
+        if (i == ISSI_PERSISTENCE) {
+            success = false;
+        }
+#else
+        if (i2c_writeReg(addr << 1, offset + ISSI_PWM_REG_1ST, source_buffer + offset, length, ISSI_TIMEOUT) != 0) {
+            success = false;
+        }
+#endif
+        chunk += run;
+    }
+    return success;
+}
+
 void IS31FL_unlock_register(uint8_t addr, uint8_t page) {
     // unlock the command register and select Page to write
     IS31FL_write_single_register(addr, ISSI_COMMANDREGISTER_WRITELOCK, ISSI_REGISTER_UNLOCK);
@@ -116,16 +163,28 @@ void IS31FL_common_init(uint8_t addr, uint8_t ssr) {
     IS31FL_write_single_register(addr, ISSI_REG_PWM_SET, ISSI_PWM_SET);
 #endif
 
+    // Make sure the next update writes all of the PWM registers
+    for (int i = 0; i < DRIVER_COUNT; i++) {
+        g_pwm_buffer_dirty_chunks[i]    = ISSI_PWM_CHUNKS_ALL;
+        g_pwm_buffer_update_required[i] = true;
+    }
+
     // Wait 10ms to ensure the device has woken up.
     wait_ms(10);
 }
 
 void IS31FL_common_update_pwm_register(uint8_t addr, uint8_t index) {
     if (g_pwm_buffer_update_required[index]) {
+        // The flag without any dirty chunks means the buffer was changed directly
+        uint16_t chunks = g_pwm_buffer_dirty_chunks[index] ? g_pwm_buffer_dirty_chunks[index] : ISSI_PWM_CHUNKS_ALL;
         // Queue up the correct page
         IS31FL_unlock_register(addr, ISSI_PAGE_PWM);
-        // Hand off the update to IS31FL_write_multi_registers
-        IS31FL_write_multi_registers(addr, g_pwm_buffer[index], ISSI_MAX_LEDS, ISSI_PWM_TRF_SIZE, ISSI_PWM_REG_1ST);
+        // Hand off the changed chunks, or all of them if a transfer fails
+        // as the PWM registers are then in an unknown state
+        g_pwm_buffer_dirty_chunks[index] = 0;
+        if (!IS31FL_write_pwm_chunks(addr, g_pwm_buffer[index], chunks)) {
+            g_pwm_buffer_dirty_chunks[index] = ISSI_PWM_CHUNKS_ALL;
+        }
         // Update flags that pwm_buffer has been updated
         g_pwm_buffer_update_required[index] = false;
     }
@@ -162,16 +221,24 @@ void IS31FL_common_update_scaling_register(uint8_t addr, uint8_t index) {
     }
 }
 
+// Only marks the register's chunk as dirty if the value actually changed
+static inline void IS31FL_set_pwm(uint8_t driver, uint8_t reg, uint8_t value) {
+    if (g_pwm_buffer[driver][reg] != value) {
+        g_pwm_buffer[driver][reg]            = value;
+        g_pwm_buffer_dirty_chunks[driver]   |= 1 << (reg / ISSI_PWM_TRF_SIZE);
+        g_pwm_buffer_update_required[driver] = true;
+    }
+}
+
 #ifdef RGB_MATRIX_ENABLE
 // Colour is set by adjusting PWM register
 void IS31FL_RGB_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
     if (index >= 0 && index < DRIVER_LED_TOTAL) {
         is31_led led = g_is31_leds[index];
 
-        g_pwm_buffer[led.driver][led.r]          = red;
-        g_pwm_buffer[led.driver][led.g]          = green;
-        g_pwm_buffer[led.driver][led.b]          = blue;
-        g_pwm_buffer_update_required[led.driver] = true;
+        IS31FL_set_pwm(led.driver, led.r, red);
+        IS31FL_set_pwm(led.driver, led.g, green);
+        IS31FL_set_pwm(led.driver, led.b, blue);
     }
 }
 
@@ -217,8 +284,7 @@ void IS31FL_simple_set_scaling_buffer(uint8_t index, bool value) {
 void IS31FL_simple_set_brightness(int index, uint8_t value) {
     if (index >= 0 && index < DRIVER_LED_TOTAL) {
         is31_led led = g_is31_leds[index];
-        g_pwm_buffer[led.driver][led.v] = value;
-        g_pwm_buffer_update_required[led.driver] = true;
+        IS31FL_set_pwm(led.driver, led.v, value);
     }
 }
 
@@ -234,6 +234,10 @@ void oled_pan(bool left);
 // buffer length as struct
 oled_buffer_reader_t oled_read_raw(uint16_t start_index);
 
+// Returns the blocks of the buffer written to since the last call, whether or not they
+// have been rendered yet, so that the contents can be mirrored elsewhere
+OLED_BLOCK_TYPE oled_take_changed_blocks(void);
+
 // Writes a string to the buffer at current cursor position
 void oled_write_raw(const char *data, uint16_t size);
 
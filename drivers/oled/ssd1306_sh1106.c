@@ -95,13 +95,20 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 // i2c defines
 #define I2C_CMD 0x00
 #define I2C_DATA 0x40
+#if defined(I2C_ASYNC_ENABLE)
+#    include "i2c_async.h"
+// Blocking commands wait for the queued render, which relies on the addressing it set up
+#    define I2C_SYNC() i2c_async_flush()
+#else
+#    define I2C_SYNC() ((void)0)
+#endif
 #if defined(__AVR__)
-#    define I2C_TRANSMIT_P(data) i2c_transmit_P((OLED_DISPLAY_ADDRESS << 1), &data[0], sizeof(data), OLED_I2C_TIMEOUT)
+#    define I2C_TRANSMIT_P(data) (I2C_SYNC(), i2c_transmit_P((OLED_DISPLAY_ADDRESS << 1), &data[0], sizeof(data), OLED_I2C_TIMEOUT))
 #else // defined(__AVR__)
-#    define I2C_TRANSMIT_P(data) i2c_transmit((OLED_DISPLAY_ADDRESS << 1), &data[0], sizeof(data), OLED_I2C_TIMEOUT)
+#    define I2C_TRANSMIT_P(data) (I2C_SYNC(), i2c_transmit((OLED_DISPLAY_ADDRESS << 1), &data[0], sizeof(data), OLED_I2C_TIMEOUT))
 #endif // defined(__AVR__)
-#define I2C_TRANSMIT(data) i2c_transmit((OLED_DISPLAY_ADDRESS << 1), &data[0], sizeof(data), OLED_I2C_TIMEOUT)
-#define I2C_WRITE_REG(mode, data, size) i2c_writeReg((OLED_DISPLAY_ADDRESS << 1), mode, data, size, OLED_I2C_TIMEOUT)
+#define I2C_TRANSMIT(data) (I2C_SYNC(), i2c_transmit((OLED_DISPLAY_ADDRESS << 1), &data[0], sizeof(data), OLED_I2C_TIMEOUT))
+#define I2C_WRITE_REG(mode, data, size) (I2C_SYNC(), i2c_writeReg((OLED_DISPLAY_ADDRESS << 1), mode, data, size, OLED_I2C_TIMEOUT))
 
 #define HAS_FLAGS(bits, flags) ((bits & flags) == flags)
 
@@ -112,6 +119,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 uint8_t         oled_buffer[OLED_MATRIX_SIZE];
 uint8_t *       oled_cursor;
 OLED_BLOCK_TYPE oled_dirty          = 0;
+OLED_BLOCK_TYPE oled_changed        = 0;
 bool            oled_initialized    = false;
 bool            oled_active         = false;
 bool            oled_scrolling      = false;
@@ -239,10 +247,16 @@ __attribute__((weak)) oled_rotation_t oled_init_user(oled_rotation_t rotation) {
     return rotation;
 }
 
+// Blocks that need rendering, and separately, blocks whose contents changed for oled_take_changed_blocks()
+static inline void oled_mark_dirty(OLED_BLOCK_TYPE blocks) {
+    oled_dirty |= blocks;
+    oled_changed |= blocks;
+}
+
 void oled_clear(void) {
     memset(oled_buffer, 0, sizeof(oled_buffer));
     oled_cursor = &oled_buffer[0];
-    oled_dirty  = OLED_ALL_BLOCKS_MASK;
+    oled_mark_dirty(OLED_ALL_BLOCKS_MASK);
 }
 
 static void calc_bounds(uint8_t update_start, uint8_t *cmd_array) {
@@ -290,11 +304,33 @@ static void rotate_90(const uint8_t *src, uint8_t *dest) {
     }
 }
 
+#if defined(I2C_ASYNC_ENABLE)
+static void render_transaction_done(i2c_async_transaction_t *transaction);
+
+// Column & page position followed by the block's data, the context holds the block's index
+static i2c_async_transaction_t render_offset = {.op = I2C_ASYNC_TRANSMIT, .address = (OLED_DISPLAY_ADDRESS << 1), .timeout = OLED_I2C_TIMEOUT, .callback = render_transaction_done};
+static i2c_async_transaction_t render_data   = {.op = I2C_ASYNC_WRITE_REG, .address = (OLED_DISPLAY_ADDRESS << 1), .reg = I2C_DATA, .length = OLED_BLOCK_SIZE, .timeout = OLED_I2C_TIMEOUT, .callback = render_transaction_done};
+
+static void render_transaction_done(i2c_async_transaction_t *transaction) {
+    if (transaction->status != I2C_STATUS_SUCCESS) {
+        print("oled_render failed\n");
+        oled_dirty |= (OLED_BLOCK_TYPE)1 << (uintptr_t)transaction->context;
+    }
+}
+#endif
+
 void oled_render(void) {
     if (!oled_initialized) {
         return;
     }
 
+#if defined(I2C_ASYNC_ENABLE)
+    // The previous block is still on its way to the display
+    if (render_offset.pending || render_data.pending) {
+        return;
+    }
+#endif
+
     // Do we have work to do?
     oled_dirty &= OLED_ALL_BLOCKS_MASK;
     if (!oled_dirty || oled_scrolling) {
@@ -315,18 +351,34 @@ void oled_render(void) {
         calc_bounds_90(update_start, &display_start[1]); // Offset from I2C_CMD byte at the start
     }
 
+#if defined(I2C_ASYNC_ENABLE)
+    // Queue column & page position, the block is marked dirty again if either transfer fails.
+    // Blocks that change while they are being sent are marked dirty again anyway, so the
+    // data is sent straight from oled_buffer, and temp_buffer is only reused once it was sent.
+    render_offset.data    = display_start;
+    render_offset.length  = sizeof(display_start);
+    render_offset.context = (void *)(uintptr_t)update_start;
+    render_data.context   = (void *)(uintptr_t)update_start;
+    i2c_async_submit(&render_offset);
+#else
     // Send column & page position
     if (I2C_TRANSMIT(display_start) != I2C_STATUS_SUCCESS) {
         print("oled_render offset command failed\n");
         return;
     }
+#endif
 
     if (!HAS_FLAGS(oled_rotation, OLED_ROTATION_90)) {
         // Send render data chunk as is
+#if defined(I2C_ASYNC_ENABLE)
+        render_data.data = &oled_buffer[OLED_BLOCK_SIZE * update_start];
+        i2c_async_submit(&render_data);
+#else
         if (I2C_WRITE_REG(I2C_DATA, &oled_buffer[OLED_BLOCK_SIZE * update_start], OLED_BLOCK_SIZE) != I2C_STATUS_SUCCESS) {
             print("oled_render data failed\n");
             return;
         }
+#endif
     } else {
         // Rotate the render chunks
         const static uint8_t source_map[] = OLED_SOURCE_MAP;
@@ -339,10 +391,15 @@ void oled_render(void) {
         }
 
         // Send render data chunk after rotating
+#if defined(I2C_ASYNC_ENABLE)
+        render_data.data = &temp_buffer[0];
+        i2c_async_submit(&render_data);
+#else
         if (I2C_WRITE_REG(I2C_DATA, &temp_buffer[0], OLED_BLOCK_SIZE) != I2C_STATUS_SUCCESS) {
             print("oled_render90 data failed\n");
             return;
         }
+#endif
     }
 
     // Turn on display if it is off
@@ -440,9 +497,9 @@ void oled_write_char(const char data, bool invert) {
     // Dirty check
     if (memcmp(&oled_temp_buffer, oled_cursor, OLED_FONT_WIDTH)) {
         uint16_t index = oled_cursor - &oled_buffer[0];
-        oled_dirty |= ((OLED_BLOCK_TYPE)1 << (index / OLED_BLOCK_SIZE));
+        oled_mark_dirty((OLED_BLOCK_TYPE)1 << (index / OLED_BLOCK_SIZE));
         // Edgecase check if the written data spans the 2 chunks
-        oled_dirty |= ((OLED_BLOCK_TYPE)1 << ((index + OLED_FONT_WIDTH - 1) / OLED_BLOCK_SIZE));
+        oled_mark_dirty((OLED_BLOCK_TYPE)1 << ((index + OLED_FONT_WIDTH - 1) / OLED_BLOCK_SIZE));
     }
 
     // Finally move to the next char
@@ -477,7 +534,7 @@ void oled_pan(bool left) {
             }
         }
     }
-    oled_dirty = OLED_ALL_BLOCKS_MASK;
+    oled_mark_dirty(OLED_ALL_BLOCKS_MASK);
 }
 
 oled_buffer_reader_t oled_read_raw(uint16_t start_index) {
@@ -488,11 +545,17 @@ oled_buffer_reader_t oled_read_raw(uint16_t start_index) {
     return ret_reader;
 }
 
+OLED_BLOCK_TYPE oled_take_changed_blocks(void) {
+    OLED_BLOCK_TYPE changed = oled_changed & OLED_ALL_BLOCKS_MASK;
+    oled_changed            = 0;
+    return changed;
+}
+
 void oled_write_raw_byte(const char data, uint16_t index) {
     if (index > OLED_MATRIX_SIZE) index = OLED_MATRIX_SIZE;
     if (oled_buffer[index] == data) return;
     oled_buffer[index] = data;
-    oled_dirty |= ((OLED_BLOCK_TYPE)1 << (index / OLED_BLOCK_SIZE));
+    oled_mark_dirty((OLED_BLOCK_TYPE)1 << (index / OLED_BLOCK_SIZE));
 }
 
 void oled_write_raw(const char *data, uint16_t size) {
@@ -502,7 +565,7 @@ void oled_write_raw(const char *data, uint16_t size) {
         uint8_t c = *data++;
         if (oled_buffer[i] == c) continue;
         oled_buffer[i] = c;
-        oled_dirty |= ((OLED_BLOCK_TYPE)1 << (i / OLED_BLOCK_SIZE));
+        oled_mark_dirty((OLED_BLOCK_TYPE)1 << (i / OLED_BLOCK_SIZE));
     }
 }
 
@@ -522,7 +585,7 @@ void oled_write_pixel(uint8_t x, uint8_t y, bool on) {
     }
     if (oled_buffer[index] != data) {
         oled_buffer[index] = data;
-        oled_dirty |= ((OLED_BLOCK_TYPE)1 << (index / OLED_BLOCK_SIZE));
+        oled_mark_dirty((OLED_BLOCK_TYPE)1 << (index / OLED_BLOCK_SIZE));
     }
 }
 
@@ -547,7 +610,7 @@ void oled_write_raw_P(const char *data, uint16_t size) {
         uint8_t c = pgm_read_byte(data++);
         if (oled_buffer[i] == c) continue;
         oled_buffer[i] = c;
-        oled_dirty |= ((OLED_BLOCK_TYPE)1 << (i / OLED_BLOCK_SIZE));
+        oled_mark_dirty((OLED_BLOCK_TYPE)1 << (i / OLED_BLOCK_SIZE));
     }
 }
 #endif // defined(__AVR__)
@@ -27,3 +27,12 @@ void soft_serial_initiator_init(void);
 void soft_serial_target_init(void);
 
 bool soft_serial_transaction(int sstd_index);
+
+#ifdef SPLIT_TRANSACTION_ASYNC
+// start a transaction in the background, returns false if one is already running
+bool soft_serial_transaction_begin(int sstd_index);
+// returns true once the background transaction has finished, with its outcome in success
+bool soft_serial_transaction_complete(bool *success);
+// blocks until the background transaction has finished, must not be called with the system locked
+void soft_serial_transaction_wait(void);
+#endif
@@ -79,3 +79,13 @@ typedef uint8_t pin_t;
 #define readPin(pin) ((PORT->Group[SAMD_PORT(pin)].IN.reg & SAMD_PIN_MASK(pin)) != 0)
 
 #define togglePin(pin) (PORT->Group[SAMD_PORT(pin)].OUTTGL.reg = SAMD_PIN_MASK(pin))
+
+/* Operation of GPIO by port. */
+
+typedef uint8_t  port_t;
+typedef uint32_t port_data_t;
+
+#define getPinPort(pin) SAMD_PORT(pin)
+#define getPinPad(pin) SAMD_PIN(pin)
+
+#define readPort(port) ((port_data_t)PORT->Group[(port)].IN.reg)
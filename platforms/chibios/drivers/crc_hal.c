@@ -0,0 +1,52 @@
+/* Copyright 2021 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * One-shot CRC-32 on the CRC peripheral, through the ChibiOS-Contrib CRC
+ * driver. The incremental API, CRC-8 and CRC-16 stay in software, as the
+ * unit is shared and cannot hold a partial result between calls.
+ */
+
+#include "crc.h"
+#include <ch.h>
+#include <hal.h>
+
+#if !HAL_USE_CRC
+#    error "You need to set HAL_USE_CRC to TRUE in your halconf.h to use the CRC driver."
+#endif
+
+#ifndef CRC_HAL_DRIVER
+#    define CRC_HAL_DRIVER CRCD1
+#endif
+
+// CRC-32/ISO-HDLC, matching the software implementation
+static const CRCConfig crc32_config = {
+    .poly_size         = 32,
+    .poly              = 0x04C11DB7,
+    .initial_val       = 0xFFFFFFFF,
+    .final_val         = 0xFFFFFFFF,
+    .reflect_data      = true,
+    .reflect_remainder = true,
+};
+
+void crc_init(void) {
+    crcStart(&CRC_HAL_DRIVER, &crc32_config);
+}
+
+uint32_t crc32(const void *data, size_t data_len) {
+    crcReset(&CRC_HAL_DRIVER);
+    return crcCalc(&CRC_HAL_DRIVER, data_len, data);
+}
@@ -88,6 +88,24 @@
 #    endif
 #endif
 
+#if defined(I2C_ASYNC_ENABLE)
+#    include "i2c_async.h"
+
+#    if !I2C_USE_MUTUAL_EXCLUSION
+#        error "I2C_ASYNC_ENABLE requires I2C_USE_MUTUAL_EXCLUSION to be TRUE in halconf.h"
+#    endif
+#    ifndef I2C_ASYNC_THREAD_STACK_SIZE
+#        define I2C_ASYNC_THREAD_STACK_SIZE 1024
+#    endif
+
+// The bus is shared with the thread running the queued transactions
+#    define i2c_acquire() i2cAcquireBus(&I2C_DRIVER)
+#    define i2c_release() i2cReleaseBus(&I2C_DRIVER)
+#else
+#    define i2c_acquire()
+#    define i2c_release()
+#endif
+
 static uint8_t i2c_address;
 
 static const I2CConfig i2cconfig = {
@@ -140,26 +158,33 @@ __attribute__((weak)) void i2c_init(void) {
 }
 
 i2c_status_t i2c_start(uint8_t address) {
+    i2c_acquire();
     i2c_address = address;
     i2cStart(&I2C_DRIVER, &i2cconfig);
+    i2c_release();
     return I2C_STATUS_SUCCESS;
 }
 
 i2c_status_t i2c_transmit(uint8_t address, const uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_acquire();
     i2c_address = address;
     i2cStart(&I2C_DRIVER, &i2cconfig);
     msg_t status = i2cMasterTransmitTimeout(&I2C_DRIVER, (i2c_address >> 1), data, length, 0, 0, TIME_MS2I(timeout));
+    i2c_release();
     return chibios_to_qmk(&status);
 }
 
 i2c_status_t i2c_receive(uint8_t address, uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_acquire();
     i2c_address = address;
     i2cStart(&I2C_DRIVER, &i2cconfig);
     msg_t status = i2cMasterReceiveTimeout(&I2C_DRIVER, (i2c_address >> 1), data, length, TIME_MS2I(timeout));
+    i2c_release();
     return chibios_to_qmk(&status);
 }
 
 i2c_status_t i2c_writeReg(uint8_t devaddr, uint8_t regaddr, const uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_acquire();
     i2c_address = devaddr;
     i2cStart(&I2C_DRIVER, &i2cconfig);
 
@@ -170,10 +195,12 @@ i2c_status_t i2c_writeReg(uint8_t devaddr, uint8_t regaddr, const uint8_t* data,
     complete_packet[0] = regaddr;
 
     msg_t status = i2cMasterTransmitTimeout(&I2C_DRIVER, (i2c_address >> 1), complete_packet, length + 1, 0, 0, TIME_MS2I(timeout));
+    i2c_release();
     return chibios_to_qmk(&status);
 }
 
 i2c_status_t i2c_writeReg16(uint8_t devaddr, uint16_t regaddr, const uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_acquire();
     i2c_address = devaddr;
     i2cStart(&I2C_DRIVER, &i2cconfig);
 
@@ -185,24 +212,80 @@ i2c_status_t i2c_writeReg16(uint8_t devaddr, uint16_t regaddr, const uint8_t* da
     complete_packet[1] = regaddr & 0xFF;
 
     msg_t status = i2cMasterTransmitTimeout(&I2C_DRIVER, (i2c_address >> 1), complete_packet, length + 2, 0, 0, TIME_MS2I(timeout));
+    i2c_release();
     return chibios_to_qmk(&status);
 }
 
 i2c_status_t i2c_readReg(uint8_t devaddr, uint8_t regaddr, uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_acquire();
     i2c_address = devaddr;
     i2cStart(&I2C_DRIVER, &i2cconfig);
     msg_t status = i2cMasterTransmitTimeout(&I2C_DRIVER, (i2c_address >> 1), &regaddr, 1, data, length, TIME_MS2I(timeout));
+    i2c_release();
     return chibios_to_qmk(&status);
 }
 
 i2c_status_t i2c_readReg16(uint8_t devaddr, uint16_t regaddr, uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_acquire();
     i2c_address = devaddr;
     i2cStart(&I2C_DRIVER, &i2cconfig);
     uint8_t register_packet[2] = {regaddr >> 8, regaddr & 0xFF};
     msg_t   status             = i2cMasterTransmitTimeout(&I2C_DRIVER, (i2c_address >> 1), register_packet, 2, data, length, TIME_MS2I(timeout));
+    i2c_release();
     return chibios_to_qmk(&status);
 }
 
 void i2c_stop(void) {
+    i2c_acquire();
     i2cStop(&I2C_DRIVER);
+    i2c_release();
 }
+
+#if defined(I2C_ASYNC_ENABLE)
+static binary_semaphore_t                async_start;
+static i2c_async_transaction_t* volatile async_transaction = NULL;
+static volatile bool                     async_done        = true;
+static volatile i2c_status_t             async_status      = I2C_STATUS_SUCCESS;
+
+/**
+ * @brief This thread runs the queued transactions. It sleeps while the
+ * driver's DMA moves the data, so the main loop carries on in the meantime.
+ */
+static THD_WORKING_AREA(waI2CAsyncThread, I2C_ASYNC_THREAD_STACK_SIZE);
+static THD_FUNCTION(I2CAsyncThread, arg) {
+    (void)arg;
+    chRegSetThreadName("i2c_async");
+
+    while (true) {
+        chBSemWait(&async_start);
+        i2c_status_t status = i2c_async_execute(async_transaction);
+
+        osalSysLock();
+        async_status = status;
+        async_done   = true;
+        osalSysUnlock();
+    }
+}
+
+void i2c_async_backend_start(i2c_async_transaction_t* transaction) {
+    static bool is_started = false;
+    if (!is_started) {
+        is_started = true;
+        chBSemObjectInit(&async_start, true);
+        chThdCreateStatic(waI2CAsyncThread, sizeof(waI2CAsyncThread), NORMALPRIO + 1, I2CAsyncThread, NULL);
+    }
+
+    async_transaction = transaction;
+    async_done        = false;
+    chBSemSignal(&async_start);
+}
+
+bool i2c_async_backend_poll(i2c_status_t* status) {
+    if (!async_done) {
+        return false;
+    }
+
+    *status = async_status;
+    return true;
+}
+#endif
@@ -231,6 +231,37 @@ static inline bool react_to_transactions(void) {
     return true;
 }
 
+#if defined(SPLIT_TRANSACTION_ASYNC)
+static binary_semaphore_t transaction_start;
+static binary_semaphore_t transaction_finished;
+static volatile uint8_t   transaction_index   = 0;
+static volatile bool      transaction_done    = true;
+static volatile bool      transaction_success = false;
+
+/**
+ * @brief This thread runs on the master and performs the transactions
+ * started with soft_serial_transaction_begin, so that the main loop doesn't
+ * have to wait for them.
+ */
+static THD_WORKING_AREA(waMasterThread, 1024);
+static THD_FUNCTION(MasterThread, arg) {
+    (void)arg;
+    chRegSetThreadName("usart_master");
+
+    while (true) {
+        chBSemWait(&transaction_start);
+        usart_clear();
+        bool success = initiate_transaction(transaction_index);
+
+        osalSysLock();
+        transaction_success = success;
+        transaction_done    = true;
+        chBSemSignalI(&transaction_finished);
+        osalSysUnlock();
+    }
+}
+#endif
+
 /**
  * @brief Master specific initializations.
  */
@@ -242,6 +273,12 @@ void soft_serial_initiator_init(void) {
 #endif
 
     sdStart(serial_driver, &serial_config);
+
+#if defined(SPLIT_TRANSACTION_ASYNC)
+    chBSemObjectInit(&transaction_start, true);
+    chBSemObjectInit(&transaction_finished, true);
+    chThdCreateStatic(waMasterThread, sizeof(waMasterThread), HIGHPRIO, MasterThread, NULL);
+#endif
 }
 
 /**
@@ -251,12 +288,67 @@ void soft_serial_initiator_init(void) {
  * @return bool Indicates success of transaction.
  */
 bool soft_serial_transaction(int index) {
+#if defined(SPLIT_TRANSACTION_ASYNC)
+    /* A background transaction is still using the line. This can be called
+     * with the system locked, so callers wait with soft_serial_transaction_wait
+     * beforehand instead of sleeping here. */
+    if (!transaction_done) {
+        return false;
+    }
+#endif
+
     /* Clear the receive queue, to start with a clean slate.
      * Parts of failed transactions or spurious bytes could still be in it. */
     usart_clear();
     return initiate_transaction((uint8_t)index);
 }
 
+#if defined(SPLIT_TRANSACTION_ASYNC)
+/**
+ * @brief Start transaction from the master half to the slave half, without
+ * waiting for it to finish.
+ *
+ * @param index Transaction Table index of the transaction to start.
+ * @return bool Indicates whether the transaction was started.
+ */
+bool soft_serial_transaction_begin(int index) {
+    if (!transaction_done) {
+        return false;
+    }
+
+    transaction_index = (uint8_t)index;
+    transaction_done  = false;
+    chBSemSignal(&transaction_start);
+    return true;
+}
+
+/**
+ * @brief Check on the transaction started by soft_serial_transaction_begin.
+ *
+ * @param success Set to the outcome of the transaction once finished.
+ * @return bool Indicates whether the transaction has finished.
+ */
+bool soft_serial_transaction_complete(bool* success) {
+    if (!transaction_done) {
+        return false;
+    }
+
+    *success = transaction_success;
+    return true;
+}
+
+/**
+ * @brief Block until the transaction started by soft_serial_transaction_begin
+ * has finished, if there is one. Must not be called with the system locked.
+ */
+void soft_serial_transaction_wait(void) {
+    while (!transaction_done) {
+        /* Can return for a transaction that finished earlier without anyone waiting on it, hence the loop. */
+        chBSemWait(&transaction_finished);
+    }
+}
+#endif
+
 /**
  * @brief Initiate transaction to slave half.
  */
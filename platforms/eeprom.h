@@ -58,8 +58,9 @@ void     eeprom_update_block(const void *__src, void *__dst, size_t __n);
 #    define TOTAL_EEPROM_BYTE_COUNT 4096
 #elif defined(EEPROM_TEST_HARNESS)
 #    ifndef FLASH_STM32_MOCKED
-// Normal tests
-#        define TOTAL_EEPROM_BYTE_COUNT 32
+// Normal tests, sized to hold all of eeconfig
+#        include "eeconfig.h"
+#        define TOTAL_EEPROM_BYTE_COUNT (((EECONFIG_SIZE + 3) / 4) * 4)
 #    else
 // Flash wear-leveling testing
 #        include "eeprom_stm32_tests.h"
@@ -0,0 +1,163 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <string.h>
+
+#include "i2c_master.h"
+
+#define I2C_MOCK_DEVICES 128
+
+typedef struct i2c_mock_device_t {
+    bool    attached;
+    uint8_t pointer;
+    uint8_t registers[256];
+} i2c_mock_device_t;
+
+static i2c_mock_device_t devices[I2C_MOCK_DEVICES];
+static i2c_mock_stats_t  stats;
+static uint16_t          latency;
+
+static i2c_mock_device_t* find_device(uint8_t address) {
+    stats.transfers++;
+    i2c_mock_device_t* device = &devices[(address >> 1) % I2C_MOCK_DEVICES];
+    return device->attached ? device : NULL;
+}
+
+static void device_write(i2c_mock_device_t* device, const uint8_t* data, uint16_t length) {
+    stats.bytes += length;
+    for (uint16_t i = 0; i < length; ++i) {
+        device->registers[device->pointer++] = data[i];
+    }
+}
+
+static void device_read(i2c_mock_device_t* device, uint8_t* data, uint16_t length) {
+    stats.bytes += length;
+    for (uint16_t i = 0; i < length; ++i) {
+        data[i] = device->registers[device->pointer++];
+    }
+}
+
+void i2c_init(void) {}
+
+i2c_status_t i2c_start(uint8_t address) {
+    return find_device(address) ? I2C_STATUS_SUCCESS : I2C_STATUS_ERROR;
+}
+
+i2c_status_t i2c_transmit(uint8_t address, const uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_mock_device_t* device = find_device(address);
+    if (!device) {
+        return I2C_STATUS_ERROR;
+    }
+
+    if (length > 0) {
+        stats.bytes++;
+        device->pointer = data[0];
+        device_write(device, data + 1, length - 1);
+    }
+    return I2C_STATUS_SUCCESS;
+}
+
+i2c_status_t i2c_receive(uint8_t address, uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_mock_device_t* device = find_device(address);
+    if (!device) {
+        return I2C_STATUS_ERROR;
+    }
+
+    device_read(device, data, length);
+    return I2C_STATUS_SUCCESS;
+}
+
+i2c_status_t i2c_writeReg(uint8_t devaddr, uint8_t regaddr, const uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_mock_device_t* device = find_device(devaddr);
+    if (!device) {
+        return I2C_STATUS_ERROR;
+    }
+
+    stats.bytes++;
+    device->pointer = regaddr;
+    device_write(device, data, length);
+    return I2C_STATUS_SUCCESS;
+}
+
+i2c_status_t i2c_writeReg16(uint8_t devaddr, uint16_t regaddr, const uint8_t* data, uint16_t length, uint16_t timeout) {
+    // The devices only have 8 bit register addresses, the high byte is ignored
+    return i2c_writeReg(devaddr, regaddr & 0xFF, data, length, timeout);
+}
+
+i2c_status_t i2c_readReg(uint8_t devaddr, uint8_t regaddr, uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_mock_device_t* device = find_device(devaddr);
+    if (!device) {
+        return I2C_STATUS_ERROR;
+    }
+
+    stats.bytes++;
+    device->pointer = regaddr;
+    device_read(device, data, length);
+    return I2C_STATUS_SUCCESS;
+}
+
+i2c_status_t i2c_readReg16(uint8_t devaddr, uint16_t regaddr, uint8_t* data, uint16_t length, uint16_t timeout) {
+    return i2c_readReg(devaddr, regaddr & 0xFF, data, length, timeout);
+}
+
+void i2c_stop(void) {}
+
+void i2c_mock_reset(void) {
+    memset(devices, 0, sizeof(devices));
+    memset(&stats, 0, sizeof(stats));
+    latency = 0;
+}
+
+void i2c_mock_attach(uint8_t address) {
+    i2c_mock_device_t* device = &devices[address % I2C_MOCK_DEVICES];
+    memset(device, 0, sizeof(*device));
+    device->attached = true;
+}
+
+uint8_t* i2c_mock_registers(uint8_t address) {
+    return devices[address % I2C_MOCK_DEVICES].registers;
+}
+
+void i2c_mock_set_latency(uint16_t polls) {
+    latency = polls;
+}
+
+const i2c_mock_stats_t* i2c_mock_get_stats(void) {
+    return &stats;
+}
+
+#if defined(I2C_ASYNC_ENABLE)
+#    include "i2c_async.h"
+
+static i2c_async_transaction_t* async_transaction;
+static uint16_t                 async_polls;
+
+// The transfer happens when the transaction finishes, so tests can watch it being in flight
+void i2c_async_backend_start(i2c_async_transaction_t* transaction) {
+    async_transaction = transaction;
+    async_polls       = latency;
+}
+
+bool i2c_async_backend_poll(i2c_status_t* status) {
+    if (async_polls > 0) {
+        async_polls--;
+        return false;
+    }
+
+    *status = i2c_async_execute(async_transaction);
+    return true;
+}
+#endif
@@ -0,0 +1,56 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* Simulated I2C bus for the tests, with the same API as the ChibiOS and AVR
+ * libraries. Addresses are expected to be already shifted (addr << 1).
+ * Attached devices are plain register files: the first byte of a write sets
+ * the register pointer, which then increments with every byte transferred.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef int16_t i2c_status_t;
+
+#define I2C_STATUS_SUCCESS (0)
+#define I2C_STATUS_ERROR (-1)
+#define I2C_STATUS_TIMEOUT (-2)
+
+void         i2c_init(void);
+i2c_status_t i2c_start(uint8_t address);
+i2c_status_t i2c_transmit(uint8_t address, const uint8_t* data, uint16_t length, uint16_t timeout);
+i2c_status_t i2c_receive(uint8_t address, uint8_t* data, uint16_t length, uint16_t timeout);
+i2c_status_t i2c_writeReg(uint8_t devaddr, uint8_t regaddr, const uint8_t* data, uint16_t length, uint16_t timeout);
+i2c_status_t i2c_writeReg16(uint8_t devaddr, uint16_t regaddr, const uint8_t* data, uint16_t length, uint16_t timeout);
+i2c_status_t i2c_readReg(uint8_t devaddr, uint8_t regaddr, uint8_t* data, uint16_t length, uint16_t timeout);
+i2c_status_t i2c_readReg16(uint8_t devaddr, uint16_t regaddr, uint8_t* data, uint16_t length, uint16_t timeout);
+void         i2c_stop(void);
+
+typedef struct i2c_mock_stats_t {
+    uint32_t transfers; // transfers attempted, including ones to missing devices
+    uint32_t bytes;     // bytes moved to or from attached devices, including register addresses
+} i2c_mock_stats_t;
+
+// Detaches every device, and clears the statistics and the latency.
+void i2c_mock_reset(void);
+// Attaches a device with all of its registers cleared, the address is not shifted.
+void i2c_mock_attach(uint8_t address);
+// The registers of an attached device, the address is not shifted.
+uint8_t* i2c_mock_registers(uint8_t address);
+// How many calls to i2c_async_backend_poll() a queued transaction takes to finish.
+void                    i2c_mock_set_latency(uint16_t polls);
+const i2c_mock_stats_t* i2c_mock_get_stats(void);
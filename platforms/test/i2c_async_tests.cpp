@@ -0,0 +1,211 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include <string.h>
+#include <vector>
+
+extern "C" {
+#include "i2c_master.h"
+#include "i2c_async.h"
+#include "is31fl3733.h"
+
+const is31_led PROGMEM g_is31_leds[DRIVER_LED_TOTAL] = {
+    {0, A_1, B_1, C_1},
+    {0, A_16, B_16, C_16},
+    {0, L_16, K_16, J_16},
+};
+
+extern uint8_t  g_pwm_buffer[DRIVER_COUNT][192];
+extern bool     g_pwm_buffer_update_required[DRIVER_COUNT];
+extern uint16_t g_pwm_buffer_dirty_chunks[DRIVER_COUNT];
+}
+
+#define DEVICE 0x50
+#define MISSING 0x51
+
+static std::vector<int> completed;
+
+static void record_completion(i2c_async_transaction_t *transaction) {
+    completed.push_back((int)(intptr_t)transaction->context);
+}
+
+class I2cAsync : public testing::Test {
+   public:
+    I2cAsync() {
+        i2c_async_flush();
+        i2c_mock_reset();
+        i2c_mock_attach(DEVICE);
+        memset(g_pwm_buffer, 0, sizeof(g_pwm_buffer));
+        completed.clear();
+    }
+    ~I2cAsync() {
+        i2c_async_flush();
+    }
+
+    i2c_async_transaction_t write_reg(uint8_t address, uint8_t reg, uint8_t *data, uint16_t length, int id = 0) {
+        i2c_async_transaction_t transaction = {};
+        transaction.op                      = I2C_ASYNC_WRITE_REG;
+        transaction.address                 = address << 1;
+        transaction.reg                     = reg;
+        transaction.data                    = data;
+        transaction.length                  = length;
+        transaction.timeout                 = 100;
+        transaction.callback                = record_completion;
+        transaction.context                 = (void *)(intptr_t)id;
+        return transaction;
+    }
+};
+
+TEST_F(I2cAsync, SubmitReturnsBeforeTransfer) {
+    uint8_t                 data[]      = {1, 2, 3};
+    i2c_async_transaction_t transaction = write_reg(DEVICE, 0x10, data, sizeof(data));
+
+    i2c_mock_set_latency(3);
+    EXPECT_TRUE(i2c_async_submit(&transaction));
+    for (int i = 0; i < 3; i++) {
+        i2c_async_task();
+        EXPECT_TRUE(transaction.pending);
+        EXPECT_FALSE(i2c_async_idle());
+        EXPECT_EQ(i2c_mock_registers(DEVICE)[0x10], 0);
+    }
+
+    i2c_async_task();
+    EXPECT_FALSE(transaction.pending);
+    EXPECT_TRUE(i2c_async_idle());
+    EXPECT_EQ(transaction.status, I2C_STATUS_SUCCESS);
+    EXPECT_EQ(memcmp(&i2c_mock_registers(DEVICE)[0x10], data, sizeof(data)), 0);
+    EXPECT_EQ(completed, std::vector<int>({0}));
+}
+
+TEST_F(I2cAsync, RunsInSubmitOrder) {
+    uint8_t                 values[3] = {0x11, 0x22, 0x33};
+    i2c_async_transaction_t transactions[3];
+
+    i2c_mock_set_latency(1);
+    for (int i = 0; i < 3; i++) {
+        transactions[i] = write_reg(DEVICE, 0x20, &values[i], 1, i);
+        EXPECT_TRUE(i2c_async_submit(&transactions[i]));
+    }
+
+    i2c_async_flush();
+    EXPECT_EQ(completed, std::vector<int>({0, 1, 2}));
+    EXPECT_EQ(i2c_mock_registers(DEVICE)[0x20], 0x33);
+    EXPECT_EQ(i2c_mock_get_stats()->transfers, 3);
+}
+
+TEST_F(I2cAsync, RejectsPendingTransaction) {
+    uint8_t                 data        = 0x42;
+    i2c_async_transaction_t transaction = write_reg(DEVICE, 0x00, &data, 1);
+
+    i2c_mock_set_latency(2);
+    EXPECT_TRUE(i2c_async_submit(&transaction));
+    EXPECT_FALSE(i2c_async_submit(&transaction));
+
+    EXPECT_EQ(i2c_async_wait(&transaction), I2C_STATUS_SUCCESS);
+    EXPECT_EQ(completed.size(), 1);
+    EXPECT_TRUE(i2c_async_submit(&transaction));
+}
+
+TEST_F(I2cAsync, MissingDeviceReportsError) {
+    uint8_t                 data    = 0x42;
+    i2c_async_transaction_t missing = write_reg(MISSING, 0x00, &data, 1, 1);
+    i2c_async_transaction_t present = write_reg(DEVICE, 0x00, &data, 1, 2);
+
+    EXPECT_TRUE(i2c_async_submit(&missing));
+    EXPECT_TRUE(i2c_async_submit(&present));
+    EXPECT_EQ(i2c_async_wait(&missing), I2C_STATUS_ERROR);
+    EXPECT_EQ(i2c_async_wait(&present), I2C_STATUS_SUCCESS);
+    EXPECT_EQ(completed, std::vector<int>({1, 2}));
+}
+
+TEST_F(I2cAsync, ReadsRegisters) {
+    uint8_t data[4] = {0};
+    memcpy(&i2c_mock_registers(DEVICE)[0x80], "\x01\x02\x03\x04", 4);
+
+    i2c_async_transaction_t transaction = write_reg(DEVICE, 0x80, data, sizeof(data));
+    transaction.op                      = I2C_ASYNC_READ_REG;
+
+    i2c_mock_set_latency(5);
+    EXPECT_TRUE(i2c_async_submit(&transaction));
+    EXPECT_EQ(i2c_async_wait(&transaction), I2C_STATUS_SUCCESS);
+    EXPECT_EQ(memcmp(data, "\x01\x02\x03\x04", 4), 0);
+}
+
+static i2c_async_transaction_t chained;
+
+static void submit_chained(i2c_async_transaction_t *transaction) {
+    record_completion(transaction);
+    i2c_async_submit(&chained);
+}
+
+TEST_F(I2cAsync, CallbackCanSubmit) {
+    uint8_t                 first_data  = 0x0A;
+    uint8_t                 second_data = 0x0B;
+    i2c_async_transaction_t first       = write_reg(DEVICE, 0x30, &first_data, 1, 1);
+    first.callback                      = submit_chained;
+    chained                             = write_reg(DEVICE, 0x31, &second_data, 1, 2);
+
+    i2c_mock_set_latency(1);
+    EXPECT_TRUE(i2c_async_submit(&first));
+    i2c_async_flush();
+    EXPECT_EQ(completed, std::vector<int>({1, 2}));
+    EXPECT_EQ(i2c_mock_registers(DEVICE)[0x30], 0x0A);
+    EXPECT_EQ(i2c_mock_registers(DEVICE)[0x31], 0x0B);
+}
+
+TEST_F(I2cAsync, IS31FL3733QueuesDirtyChunks) {
+    IS31FL3733_init(DEVICE, 0);
+    IS31FL3733_update_pwm_buffers(DEVICE, 0);
+    i2c_async_flush();
+
+    i2c_mock_set_latency(2);
+    IS31FL3733_set_color(0, 1, 2, 3);
+    IS31FL3733_set_color(2, 4, 5, 6);
+    uint32_t bytes = i2c_mock_get_stats()->bytes;
+    IS31FL3733_update_pwm_buffers(DEVICE, 0);
+    EXPECT_FALSE(i2c_async_idle());
+    EXPECT_EQ(i2c_mock_registers(DEVICE)[A_1], 0);
+
+    // Changes made while the update is queued wait for the next one
+    IS31FL3733_set_color(1, 7, 8, 9);
+    IS31FL3733_update_pwm_buffers(DEVICE, 0);
+    EXPECT_TRUE(g_pwm_buffer_update_required[0]);
+
+    i2c_async_flush();
+    IS31FL3733_update_pwm_buffers(DEVICE, 0);
+    i2c_async_flush();
+    EXPECT_FALSE(g_pwm_buffer_update_required[0]);
+    EXPECT_EQ(memcmp(i2c_mock_registers(DEVICE), g_pwm_buffer[0], sizeof(g_pwm_buffer[0])), 0);
+
+    // Unlock and page select for each update, then a run of three chunks for each LED changed
+    EXPECT_EQ(i2c_mock_get_stats()->bytes - bytes, 2 * 4 + 3 * (1 + 3 * 16));
+}
+
+TEST_F(I2cAsync, IS31FL3733RetriesFailedUpdate) {
+    IS31FL3733_init(MISSING, 0);
+    i2c_async_flush();
+    g_pwm_buffer_dirty_chunks[0]    = 0;
+    g_pwm_buffer_update_required[0] = false;
+
+    IS31FL3733_set_color(0, 1, 2, 3);
+    IS31FL3733_update_pwm_buffers(MISSING, 0);
+    EXPECT_FALSE(g_pwm_buffer_update_required[0]);
+
+    i2c_async_flush();
+    EXPECT_TRUE(g_pwm_buffer_update_required[0]);
+    EXPECT_EQ(g_pwm_buffer_dirty_chunks[0], 0x0FFF);
+}
@@ -22,3 +22,15 @@ eeprom_stm32_SRC := \
 	$(PLATFORM_PATH)/chibios/eeprom_stm32.c
 eeprom_stm32_tiny_SRC := $(eeprom_stm32_SRC)
 eeprom_stm32_large_SRC := $(eeprom_stm32_SRC)
+
+i2c_async_DEFS := -DI2C_ASYNC_ENABLE -DIS31FL3733 -DDRIVER_COUNT=1 -DDRIVER_LED_TOTAL=3
+
+i2c_async_INC := \
+	$(DRIVER_PATH)/led/issi
+
+i2c_async_SRC := \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/i2c_async_tests.cpp \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/$(DRIVER_DIR)/i2c_master.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c \
+	$(DRIVER_PATH)/i2c_async.c \
+	$(DRIVER_PATH)/led/issi/is31fl3733.c
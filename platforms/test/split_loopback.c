@@ -0,0 +1,184 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <string.h>
+
+#include "split_loopback.h"
+#include "transactions.h"
+#include "transport.h"
+
+#define HANDSHAKE_MAGIC 7
+#define DEFAULT_SEED 0x2545F491
+
+// The memory of whichever half is running, the other half is parked in idle_memory
+static split_shared_memory_t shared_memory;
+split_shared_memory_t *const split_shmem = &shared_memory;
+static split_shared_memory_t idle_memory;
+static bool                  slave_active = false;
+
+static split_loopback_faults_t faults;
+static split_loopback_stats_t  stats;
+static uint32_t                fault_state = DEFAULT_SEED;
+static uint32_t                timer_carry_us;
+
+void advance_time(uint32_t ms);
+
+static void swap_halves(void) {
+    split_shared_memory_t temp;
+    memcpy(&temp, &shared_memory, sizeof(temp));
+    memcpy(&shared_memory, &idle_memory, sizeof(temp));
+    memcpy(&idle_memory, &temp, sizeof(temp));
+    slave_active = !slave_active;
+}
+
+static uint32_t fault_random(void) {
+    // xorshift32, so that runs are repeatable for a given seed
+    fault_state ^= fault_state << 13;
+    fault_state ^= fault_state >> 17;
+    fault_state ^= fault_state << 5;
+    return fault_state;
+}
+
+static void wire_time(uint32_t us) {
+    stats.wire_time_us += us;
+    if (faults.advance_timer) {
+        timer_carry_us += us;
+        advance_time(timer_carry_us / 1000);
+        timer_carry_us %= 1000;
+    }
+}
+
+static bool fault_hit(uint32_t ppm) {
+    return ppm && (fault_random() % 1000000) < ppm;
+}
+
+// Puts the bytes on the wire, returns false if any of them were lost
+static bool wire_transfer(uint8_t *data, uint16_t length) {
+    for (uint16_t i = 0; i < length; ++i) {
+        stats.bytes++;
+        wire_time(faults.byte_time_us);
+        if (fault_hit(faults.drop_byte_ppm)) {
+            stats.dropped++;
+            return false;
+        }
+        for (uint8_t bit = 0; bit < 8; ++bit) {
+            if (fault_hit(faults.bit_error_ppm)) {
+                data[i] ^= (1 << bit);
+                stats.bit_errors++;
+            }
+        }
+    }
+    return true;
+}
+
+static bool loopback_transaction(int8_t id) {
+    split_transaction_desc_t *trans = &split_transaction_table[id];
+    uint8_t                   frame[sizeof(split_shared_memory_t)];
+
+    stats.transactions++;
+    wire_time(faults.delay_us);
+
+    // Transaction ID, answered by the slave with the ID XORed with the magic, like the USART driver
+    uint8_t handshake = id;
+    if (!wire_transfer(&handshake, sizeof(handshake))) {
+        return false;
+    }
+    handshake ^= HANDSHAKE_MAGIC;
+    if (!wire_transfer(&handshake, sizeof(handshake)) || handshake != (id ^ HANDSHAKE_MAGIC)) {
+        return false;
+    }
+
+    uint8_t length = trans->initiator2target_buffer_size;
+    memcpy(frame, split_trans_initiator2target_buffer(trans), length);
+    if (!wire_transfer(frame, length)) {
+        return false;
+    }
+
+    swap_halves();
+    memcpy(split_trans_initiator2target_buffer(trans), frame, length);
+    if (trans->slave_callback) {
+        trans->slave_callback(trans->initiator2target_buffer_size, split_trans_initiator2target_buffer(trans), trans->target2initiator_buffer_size, split_trans_target2initiator_buffer(trans));
+    }
+    length = trans->target2initiator_buffer_size;
+    memcpy(frame, split_trans_target2initiator_buffer(trans), length);
+    swap_halves();
+
+    if (!wire_transfer(frame, length)) {
+        return false;
+    }
+    memcpy(split_trans_target2initiator_buffer(trans), frame, length);
+    return true;
+}
+
+bool transport_execute_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length) {
+    split_transaction_desc_t *trans = &split_transaction_table[id];
+    if (initiator2target_length > 0) {
+        size_t len = trans->initiator2target_buffer_size < initiator2target_length ? trans->initiator2target_buffer_size : initiator2target_length;
+        memcpy(split_trans_initiator2target_buffer(trans), initiator2target_buf, len);
+    }
+
+    if (!loopback_transaction(id)) {
+        stats.failures++;
+        return false;
+    }
+
+    if (target2initiator_length > 0) {
+        size_t len = trans->target2initiator_buffer_size < target2initiator_length ? trans->target2initiator_buffer_size : target2initiator_length;
+        memcpy(target2initiator_buf, split_trans_target2initiator_buffer(trans), len);
+    }
+
+    return true;
+}
+
+void split_loopback_reset(void) {
+    if (slave_active) {
+        swap_halves();
+    }
+    memset(&shared_memory, 0, sizeof(shared_memory));
+    memset(&idle_memory, 0, sizeof(idle_memory));
+    memset(&faults, 0, sizeof(faults));
+    memset(&stats, 0, sizeof(stats));
+    fault_state    = DEFAULT_SEED;
+    timer_carry_us = 0;
+}
+
+void split_loopback_set_faults(const split_loopback_faults_t *new_faults) {
+    memcpy(&faults, new_faults, sizeof(faults));
+    fault_state = faults.seed ? faults.seed : DEFAULT_SEED;
+}
+
+const split_loopback_stats_t *split_loopback_get_stats(void) {
+    return &stats;
+}
+
+uint32_t split_loopback_sync_latency_us(void) {
+    return stats.cycles ? stats.wire_time_us / stats.cycles : 0;
+}
+
+bool split_loopback_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    stats.cycles++;
+    return transactions_master(master_matrix, slave_matrix);
+}
+
+void split_loopback_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    swap_halves();
+    transactions_slave(master_matrix, slave_matrix);
+    swap_halves();
+}
+
+bool split_loopback_is_slave(void) {
+    return slave_active;
+}
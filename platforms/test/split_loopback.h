@@ -0,0 +1,62 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "matrix.h"
+
+/*
+ * Split transport that links the master and the slave half inside one
+ * process. Both halves share the transaction table, but each gets its own
+ * copy of the shared memory, and every byte crossing the "wire" goes through
+ * the fault injection below.
+ */
+
+typedef struct split_loopback_faults_t {
+    uint32_t seed;           // seed for the fault generator, 0 picks a fixed default
+    uint32_t bit_error_ppm;  // chance of flipping each bit, in parts per million
+    uint32_t drop_byte_ppm;  // chance of losing each byte, failing the transaction, in parts per million
+    uint16_t byte_time_us;   // modelled time on the wire for each byte
+    uint16_t delay_us;       // modelled turnaround time added to each transaction
+    bool     advance_timer;  // advance the timer by the modelled time, so that it can be measured
+} split_loopback_faults_t;
+
+typedef struct split_loopback_stats_t {
+    uint32_t cycles;       // calls to split_loopback_master
+    uint32_t transactions; // attempted transactions, including repeats after a failure
+    uint32_t failures;     // transactions that failed, and were retried or failed the cycle
+    uint32_t bytes;        // bytes on the wire in both directions, including handshakes
+    uint32_t bit_errors;   // bits flipped by the fault injection
+    uint32_t dropped;      // bytes dropped by the fault injection
+    uint32_t wire_time_us; // modelled time spent on the wire
+} split_loopback_stats_t;
+
+// Clears both halves' shared memory, the statistics and the fault configuration.
+void split_loopback_reset(void);
+void split_loopback_set_faults(const split_loopback_faults_t *faults);
+const split_loopback_stats_t *split_loopback_get_stats(void);
+// Average modelled wire time of one master cycle.
+uint32_t split_loopback_sync_latency_us(void);
+
+// Run one cycle of the master half, returns false if valid data was not received from the slave.
+bool split_loopback_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]);
+// Run one cycle of the slave half.
+void split_loopback_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]);
+// Whether the code currently running belongs to the slave half.
+bool split_loopback_is_slave(void);
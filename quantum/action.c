@@ -42,6 +42,10 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #    include "pointing_device.h"
 #endif
 
+#ifdef INPUT_LATENCY_ENABLE
+#    include "input_latency.h"
+#endif
+
 int tp_buttons;
 
 #if defined(RETRO_TAPPING) || defined(RETRO_TAPPING_PER_KEY) || (defined(AUTO_SHIFT_ENABLE) && defined(RETRO_SHIFT))
@@ -214,6 +218,10 @@ void process_record(keyrecord_t *record) {
         return;
     }
 
+#ifdef INPUT_LATENCY_ENABLE
+    input_latency_process_record(record);
+#endif
+
     if (!process_record_quantum(record)) {
 #ifndef NO_ACTION_ONESHOT
         if (is_oneshot_layer_active() && record->event.pressed && !keymap_config.oneshot_disable) {
@@ -284,6 +284,45 @@ action_t store_or_get_action(bool pressed, keypos_t key) {
 #endif
 }
 
+#if !defined(NO_ACTION_LAYER) && defined(OPAQUE_LAYER_CACHE)
+/** \brief opaque layer cache
+ *
+ * For every key, the set of layers whose entry for that key is not transparent.
+ * Layers are indexed the first time they are active, so layers that are never
+ * turned on are never read from the keymap.
+ */
+static layer_state_t opaque_layers_cache[MATRIX_ROWS][MATRIX_COLS];
+static layer_state_t opaque_layers_indexed = 0;
+
+/** \brief invalidate opaque layer cache
+ *
+ * Must be called whenever the keymap changes, so that layers get reindexed on next use
+ */
+void opaque_layer_cache_invalidate(void) {
+    opaque_layers_indexed = 0;
+}
+
+/** \brief index layers into the opaque layer cache
+ */
+static void opaque_layer_cache_index(layer_state_t layers) {
+    for (uint8_t layer = 0; layer < MAX_LAYER; layer++) {
+        const layer_state_t layer_mask = (layer_state_t)1 << layer;
+        if (!(layers & layer_mask)) continue;
+
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                if (action_for_key(layer, (keypos_t){.row = row, .col = col}).code != ACTION_TRANSPARENT) {
+                    opaque_layers_cache[row][col] |= layer_mask;
+                } else {
+                    opaque_layers_cache[row][col] &= ~layer_mask;
+                }
+            }
+        }
+        opaque_layers_indexed |= layer_mask;
+    }
+}
+#endif
+
 /** \brief Layer switch get layer
  *
  * Gets the layer based on key info
@@ -294,6 +333,16 @@ uint8_t layer_switch_get_layer(keypos_t key) {
     action.code = ACTION_TRANSPARENT;
 
     layer_state_t layers = layer_state | default_layer_state;
+#    ifdef OPAQUE_LAYER_CACHE
+    if (key.row < MATRIX_ROWS && key.col < MATRIX_COLS) {
+        if (layers & ~opaque_layers_indexed) {
+            opaque_layer_cache_index(layers & ~opaque_layers_indexed);
+        }
+        layers &= opaque_layers_cache[key.row][key.col];
+        /* fall back to layer 0 */
+        return layers ? get_highest_layer(layers) : 0;
+    }
+#    endif
     /* check top layer first */
     for (int8_t i = MAX_LAYER - 1; i >= 0; i--) {
         if (layers & ((layer_state_t)1 << i)) {
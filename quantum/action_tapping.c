@@ -1,9 +1,11 @@
 #include <stdint.h>
 #include <stdbool.h>
+#include <string.h>
 #include "action.h"
 #include "action_layer.h"
 #include "action_tapping.h"
 #include "keycode.h"
+#include "matrix.h"
 #include "timer.h"
 
 #ifdef DEBUG_ACTION
@@ -63,8 +65,16 @@ static keyrecord_t waiting_buffer[WAITING_BUFFER_SIZE] = {};
 static uint8_t     waiting_buffer_head                 = 0;
 static uint8_t     waiting_buffer_tail                 = 0;
 
+/* Index of the waiting buffer, so lookups don't have to walk it: which matrix keys have a
+ * press or a release buffered, and how many events belong to keys outside of the matrix. */
+static matrix_row_t waiting_buffer_pressed[MATRIX_ROWS]  = {};
+static matrix_row_t waiting_buffer_released[MATRIX_ROWS] = {};
+static uint8_t      waiting_buffer_pressed_count         = 0;
+static uint8_t      waiting_buffer_unindexed_count       = 0;
+
 static bool process_tapping(keyrecord_t *record);
 static bool waiting_buffer_enq(keyrecord_t record);
+static void waiting_buffer_deq(void);
 static void waiting_buffer_clear(void);
 static bool waiting_buffer_typed(keyevent_t event);
 static bool waiting_buffer_has_anykey_pressed(void);
@@ -97,13 +107,14 @@ void action_tapping_process(keyrecord_t record) {
     if (!IS_NOEVENT(record.event) && waiting_buffer_head != waiting_buffer_tail) {
         debug("---- action_exec: process waiting_buffer -----\n");
     }
-    for (; waiting_buffer_tail != waiting_buffer_head; waiting_buffer_tail = (waiting_buffer_tail + 1) % WAITING_BUFFER_SIZE) {
+    while (waiting_buffer_tail != waiting_buffer_head) {
         if (process_tapping(&waiting_buffer[waiting_buffer_tail])) {
             debug("processed: waiting_buffer[");
             debug_dec(waiting_buffer_tail);
             debug("] = ");
             debug_record(waiting_buffer[waiting_buffer_tail]);
             debug("\n\n");
+            waiting_buffer_deq();
         } else {
             break;
         }
@@ -445,6 +456,57 @@ bool process_tapping(keyrecord_t *keyp) {
     }
 }
 
+static inline bool waiting_buffer_is_indexed(keypos_t key) {
+    return key.row < MATRIX_ROWS && key.col < MATRIX_COLS;
+}
+
+static inline matrix_row_t *waiting_buffer_index(bool pressed) {
+    return pressed ? waiting_buffer_pressed : waiting_buffer_released;
+}
+
+/** \brief Find the first buffered event of a key, starting at slot `from`
+ *
+ * Returns WAITING_BUFFER_SIZE if there is none.
+ */
+static uint8_t waiting_buffer_find(keypos_t key, bool pressed, uint8_t from) {
+    for (uint8_t i = from; i != waiting_buffer_head; i = (i + 1) % WAITING_BUFFER_SIZE) {
+        if (KEYEQ(key, waiting_buffer[i].event.key) && pressed == waiting_buffer[i].event.pressed) {
+            return i;
+        }
+    }
+    return WAITING_BUFFER_SIZE;
+}
+
+static void waiting_buffer_index_add(keyevent_t event) {
+    if (event.pressed) {
+        waiting_buffer_pressed_count++;
+    }
+    if (!waiting_buffer_is_indexed(event.key)) {
+        waiting_buffer_unindexed_count++;
+        return;
+    }
+    waiting_buffer_index(event.pressed)[event.key.row] |= (matrix_row_t)1 << event.key.col;
+}
+
+/* Called before the event at the tail is dropped from the buffer. */
+static void waiting_buffer_index_remove(keyevent_t event) {
+    if (event.pressed) {
+        waiting_buffer_pressed_count--;
+    }
+    if (!waiting_buffer_is_indexed(event.key)) {
+        waiting_buffer_unindexed_count--;
+        return;
+    }
+
+    matrix_row_t bit = (matrix_row_t)1 << event.key.col;
+    // Presses and releases of a key alternate, so the same event can only be buffered again
+    // after one of the opposite kind.
+    if ((waiting_buffer_index(!event.pressed)[event.key.row] & bit) && waiting_buffer_find(event.key, event.pressed, (waiting_buffer_tail + 1) % WAITING_BUFFER_SIZE) != WAITING_BUFFER_SIZE) {
+        return;
+    }
+    waiting_buffer_index(event.pressed)[event.key.row] &= ~bit;
+}
+
 /** \brief Waiting buffer enq
  *
  * FIXME: Needs docs
@@ -461,6 +523,7 @@ bool waiting_buffer_enq(keyrecord_t record) {
 
     waiting_buffer[waiting_buffer_head] = record;
     waiting_buffer_head                 = (waiting_buffer_head + 1) % WAITING_BUFFER_SIZE;
+    waiting_buffer_index_add(record.event);
 
     debug("waiting_buffer_enq: ");
     debug_waiting_buffer();
@@ -472,8 +535,21 @@ bool waiting_buffer_enq(keyrecord_t record) {
  * FIXME: Needs docs
  */
 void waiting_buffer_clear(void) {
-    waiting_buffer_head = 0;
-    waiting_buffer_tail = 0;
+    waiting_buffer_head            = 0;
+    waiting_buffer_tail            = 0;
+    waiting_buffer_pressed_count   = 0;
+    waiting_buffer_unindexed_count = 0;
+    memset(waiting_buffer_pressed, 0, sizeof(waiting_buffer_pressed));
+    memset(waiting_buffer_released, 0, sizeof(waiting_buffer_released));
+}
+
+/** \brief Waiting buffer deq
+ *
+ * Drops the event at the tail of the buffer.
+ */
+void waiting_buffer_deq(void) {
+    waiting_buffer_index_remove(waiting_buffer[waiting_buffer_tail].event);
+    waiting_buffer_tail = (waiting_buffer_tail + 1) % WAITING_BUFFER_SIZE;
 }
 
 /** \brief Waiting buffer typed
@@ -481,12 +557,10 @@ void waiting_buffer_clear(void) {
  * FIXME: Needs docs
  */
 bool waiting_buffer_typed(keyevent_t event) {
-    for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i = (i + 1) % WAITING_BUFFER_SIZE) {
-        if (KEYEQ(event.key, waiting_buffer[i].event.key) && event.pressed != waiting_buffer[i].event.pressed) {
-            return true;
-        }
+    if (waiting_buffer_is_indexed(event.key)) {
+        return waiting_buffer_index(!event.pressed)[event.key.row] & ((matrix_row_t)1 << event.key.col);
     }
-    return false;
+    return waiting_buffer_unindexed_count && waiting_buffer_find(event.key, !event.pressed, waiting_buffer_tail) != WAITING_BUFFER_SIZE;
 }
 
 /** \brief Waiting buffer has anykey pressed
@@ -494,10 +568,7 @@ bool waiting_buffer_typed(keyevent_t event) {
  * FIXME: Needs docs
  */
 __attribute__((unused)) bool waiting_buffer_has_anykey_pressed(void) {
-    for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i = (i + 1) % WAITING_BUFFER_SIZE) {
-        if (waiting_buffer[i].event.pressed) return true;
-    }
-    return false;
+    return waiting_buffer_pressed_count > 0;
 }
 
 /** \brief Scan buffer for tapping
@@ -509,9 +580,11 @@ void waiting_buffer_scan_tap(void) {
     if (tapping_key.tap.count > 0) return;
     // invalid state: tapping_key released && tap.count == 0
     if (!tapping_key.event.pressed) return;
+    // tapping key has not been released yet
+    if (!waiting_buffer_typed(tapping_key.event)) return;
 
-    for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i = (i + 1) % WAITING_BUFFER_SIZE) {
-        if (IS_TAPPING_KEY(waiting_buffer[i].event.key) && !waiting_buffer[i].event.pressed && WITHIN_TAPPING_TERM(waiting_buffer[i].event)) {
+    for (uint8_t i = waiting_buffer_find(tapping_key.event.key, false, waiting_buffer_tail); i != WAITING_BUFFER_SIZE; i = waiting_buffer_find(tapping_key.event.key, false, (i + 1) % WAITING_BUFFER_SIZE)) {
+        if (WITHIN_TAPPING_TERM(waiting_buffer[i].event)) {
             tapping_key.tap.count       = 1;
             waiting_buffer[i].tap.count = 1;
             process_record(&tapping_key);
@@ -18,6 +18,16 @@
 
 #include "quantum.h"
 
+/*
+ * CRC-8:  polynomial 0x31, initial value 0xFF, not reflected, no final XOR.
+ * CRC-16: CRC-16/CCITT-FALSE, polynomial 0x1021, initial value 0xFFFF, not reflected, no final XOR.
+ * CRC-32: CRC-32/ISO-HDLC as used by zlib and Ethernet, polynomial 0x04C11DB7 reflected, initial value and final XOR 0xFFFFFFFF.
+ *
+ * By default each is computed bit by bit, to keep flash usage down. Defining
+ * CRC8_USE_TABLE, CRC16_USE_TABLE or CRC32_USE_TABLE switches to a 256 entry
+ * lookup table, and CRC32_SLICE_BY_4 to four tables processing a word at a time.
+ */
+
 /**
  * The type of the CRC values.
  *
@@ -41,4 +51,44 @@ __attribute__((weak)) void crc_init(void);
  * \param[in] data_len Number of bytes in the \a data buffer.
  * \return             The calculated crc value.
  */
-__attribute__((weak)) uint8_t crc8(const void *data, size_t data_len);
\ No newline at end of file
+__attribute__((weak)) uint8_t crc8(const void *data, size_t data_len);
+
+/**
+ * Generate CRC16 value from given data.
+ *
+ * \param[in] data     Pointer to a buffer of \a data_len bytes.
+ * \param[in] data_len Number of bytes in the \a data buffer.
+ * \return             The calculated crc value.
+ */
+__attribute__((weak)) uint16_t crc16(const void *data, size_t data_len);
+
+/**
+ * Generate CRC32 value from given data.
+ *
+ * \param[in] data     Pointer to a buffer of \a data_len bytes.
+ * \param[in] data_len Number of bytes in the \a data buffer.
+ * \return             The calculated crc value.
+ */
+__attribute__((weak)) uint32_t crc32(const void *data, size_t data_len);
+
+/**
+ * Incremental calculation, for data that is not in one contiguous buffer.
+ *
+ * Start with crcN_init(), feed each piece of data through crcN_update() in
+ * order, and finish with crcN_final(). The result matches crcN() over the
+ * concatenated data.
+ *
+ * \param[in] crc      The value returned by the previous call.
+ * \param[in] data     Pointer to a buffer of \a data_len bytes.
+ * \param[in] data_len Number of bytes in the \a data buffer.
+ * \return             The updated crc value.
+ */
+uint8_t  crc8_init(void);
+uint8_t  crc8_update(uint8_t crc, const void *data, size_t data_len);
+uint8_t  crc8_final(uint8_t crc);
+uint16_t crc16_init(void);
+uint16_t crc16_update(uint16_t crc, const void *data, size_t data_len);
+uint16_t crc16_final(uint16_t crc);
+uint32_t crc32_init(void);
+uint32_t crc32_update(uint32_t crc, const void *data, size_t data_len);
+uint32_t crc32_final(uint32_t crc);
@@ -0,0 +1,201 @@
+/*
+Copyright 2022 QMK
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+Symmetric per-key algorithm using vertical counters. Behaves like sym_defer_pk,
+or like sym_eager_pk when built through sym_eager_vc.c.
+
+Instead of one 8-bit counter per key, bit n of every key's counter is kept in
+plane n, a matrix_row_t per row. A whole row of counters is decremented with a
+few bitwise operations per plane, regardless of the number of columns.
+*/
+
+#include "matrix.h"
+#include "timer.h"
+#include "quantum.h"
+#include <string.h>
+
+#ifndef DEBOUNCE
+#    define DEBOUNCE 5
+#endif
+
+// Maximum debounce: 255ms
+#if DEBOUNCE > UINT8_MAX
+#    undef DEBOUNCE
+#    define DEBOUNCE UINT8_MAX
+#endif
+
+#if DEBOUNCE > 0
+
+#    if DEBOUNCE < 2
+#        define DEBOUNCE_COUNTER_BITS 1
+#    elif DEBOUNCE < 4
+#        define DEBOUNCE_COUNTER_BITS 2
+#    elif DEBOUNCE < 8
+#        define DEBOUNCE_COUNTER_BITS 3
+#    elif DEBOUNCE < 16
+#        define DEBOUNCE_COUNTER_BITS 4
+#    elif DEBOUNCE < 32
+#        define DEBOUNCE_COUNTER_BITS 5
+#    elif DEBOUNCE < 64
+#        define DEBOUNCE_COUNTER_BITS 6
+#    elif DEBOUNCE < 128
+#        define DEBOUNCE_COUNTER_BITS 7
+#    else
+#        define DEBOUNCE_COUNTER_BITS 8
+#    endif
+
+#    define PLANE_MASK(value, bit) (((value) >> (bit)) & 1 ? ~(matrix_row_t)0 : (matrix_row_t)0)
+
+static matrix_row_t debounce_counters[MATRIX_ROWS][DEBOUNCE_COUNTER_BITS];
+static fast_timer_t last_time;
+static bool         counters_need_update;
+#    ifdef DEBOUNCE_VC_EAGER
+static bool matrix_need_update;
+#    endif
+
+static void update_debounce_counters(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, uint8_t elapsed_time);
+static void start_debounce_counters(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows);
+
+// we use num_rows rather than MATRIX_ROWS to support split keyboards
+void debounce_init(uint8_t num_rows) {
+    memset(debounce_counters, 0, sizeof(debounce_counters));
+    counters_need_update = false;
+#    ifdef DEBOUNCE_VC_EAGER
+    matrix_need_update = false;
+#    endif
+}
+
+void debounce_free(void) {}
+
+void debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed) {
+    bool updated_last = false;
+
+    if (counters_need_update) {
+        fast_timer_t now          = timer_read_fast();
+        fast_timer_t elapsed_time = TIMER_DIFF_FAST(now, last_time);
+
+        last_time    = now;
+        updated_last = true;
+        if (elapsed_time > UINT8_MAX) {
+            elapsed_time = UINT8_MAX;
+        }
+
+        if (elapsed_time > 0) {
+            update_debounce_counters(raw, cooked, num_rows, elapsed_time);
+        }
+    }
+
+#    ifdef DEBOUNCE_VC_EAGER
+    if (changed || matrix_need_update) {
+#    else
+    if (changed) {
+#    endif
+        if (!updated_last) {
+            last_time = timer_read_fast();
+        }
+
+        start_debounce_counters(raw, cooked, num_rows);
+    }
+}
+
+static inline matrix_row_t active_counters(matrix_row_t counters[]) {
+    matrix_row_t active = 0;
+    for (uint8_t bit = 0; bit < DEBOUNCE_COUNTER_BITS; bit++) {
+        active |= counters[bit];
+    }
+    return active;
+}
+
+// Subtract elapsed_time from all running counters; expired counters are cleared.
+static void update_debounce_counters(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, uint8_t elapsed_time) {
+    counters_need_update = false;
+#    ifdef DEBOUNCE_VC_EAGER
+    matrix_need_update = false;
+#    endif
+    for (uint8_t row = 0; row < num_rows; row++) {
+        matrix_row_t *counters = debounce_counters[row];
+        matrix_row_t  active   = active_counters(counters);
+        if (!active) {
+            continue;
+        }
+
+        matrix_row_t expired;
+        if (elapsed_time >= DEBOUNCE) {
+            expired = active;
+            for (uint8_t bit = 0; bit < DEBOUNCE_COUNTER_BITS; bit++) {
+                counters[bit] = 0;
+            }
+        } else {
+            // bit-parallel counters - elapsed_time, a counter expires when it is <= elapsed_time
+            matrix_row_t borrow   = 0;
+            matrix_row_t nonzero  = 0;
+            matrix_row_t diff[DEBOUNCE_COUNTER_BITS];
+            for (uint8_t bit = 0; bit < DEBOUNCE_COUNTER_BITS; bit++) {
+                matrix_row_t a = counters[bit];
+                matrix_row_t b = PLANE_MASK(elapsed_time, bit);
+
+                diff[bit] = a ^ b ^ borrow;
+                borrow    = (~a & b) | (~(a ^ b) & borrow);
+                nonzero |= diff[bit];
+            }
+            expired = active & (borrow | ~nonzero);
+
+            for (uint8_t bit = 0; bit < DEBOUNCE_COUNTER_BITS; bit++) {
+                counters[bit] = diff[bit] & active & ~expired;
+            }
+        }
+
+        if (expired != active) {
+            counters_need_update = true;
+        }
+
+#    ifdef DEBOUNCE_VC_EAGER
+        if (expired) {
+            matrix_need_update = true;
+        }
+#    else
+        cooked[row] = (cooked[row] & ~expired) | (raw[row] & expired);
+#    endif
+    }
+}
+
+static void start_debounce_counters(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows) {
+    for (uint8_t row = 0; row < num_rows; row++) {
+        matrix_row_t *counters = debounce_counters[row];
+        matrix_row_t  delta    = raw[row] ^ cooked[row];
+        matrix_row_t  start    = delta & ~active_counters(counters);
+
+#    ifndef DEBOUNCE_VC_EAGER
+        // keys that bounced back to their debounced state stop their timer
+        for (uint8_t bit = 0; bit < DEBOUNCE_COUNTER_BITS; bit++) {
+            counters[bit] &= delta;
+        }
+#    endif
+
+        if (start) {
+            for (uint8_t bit = 0; bit < DEBOUNCE_COUNTER_BITS; bit++) {
+                counters[bit] |= start & PLANE_MASK(DEBOUNCE, bit);
+            }
+            counters_need_update = true;
+#    ifdef DEBOUNCE_VC_EAGER
+            cooked[row] ^= start;
+#    endif
+        }
+    }
+}
+
+#else
+#    include "none.c"
+#endif
@@ -0,0 +1,43 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+
+#include "debounce_test_common.h"
+
+TEST_F(DebounceTest, VerticalCountersStaggeredKeysInOneRow) {
+    addEvents({
+        /* Time, Inputs, Outputs */
+        {0, {{0, 1, DOWN}}, {{0, 1, DOWN}}},
+        {1, {{0, 2, DOWN}}, {{0, 2, DOWN}}},
+        /* Release before the first key's debounce has expired */
+        {2, {{0, 1, UP}}, {}},
+
+        {5, {}, {{0, 1, UP}}},
+        {6, {{0, 2, UP}}, {{0, 2, UP}}},
+    });
+    runEvents();
+}
+
+TEST_F(DebounceTest, VerticalCountersWholeRow) {
+    addEvents({
+        /* Time, Inputs, Outputs */
+        {0, {{1, 0, DOWN}, {1, 1, DOWN}, {1, 2, DOWN}, {1, 3, DOWN}, {1, 4, DOWN}, {1, 5, DOWN}, {1, 6, DOWN}, {1, 7, DOWN}, {1, 8, DOWN}, {1, 9, DOWN}}, {{1, 0, DOWN}, {1, 1, DOWN}, {1, 2, DOWN}, {1, 3, DOWN}, {1, 4, DOWN}, {1, 5, DOWN}, {1, 6, DOWN}, {1, 7, DOWN}, {1, 8, DOWN}, {1, 9, DOWN}}},
+
+        {5, {{1, 0, UP}, {1, 9, UP}}, {{1, 0, UP}, {1, 9, UP}}},
+    });
+    runEvents();
+}
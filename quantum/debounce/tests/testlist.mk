@@ -4,4 +4,6 @@ TEST_LIST += \
 	debounce_sym_defer_pr \
 	debounce_sym_eager_pk \
 	debounce_sym_eager_pr \
+	debounce_sym_defer_vc \
+	debounce_sym_eager_vc \
 	debounce_asym_eager_defer_pk
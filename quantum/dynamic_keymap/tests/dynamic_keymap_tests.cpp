@@ -0,0 +1,164 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "keycode.h"
+#include "eeprom.h"
+#include "dynamic_keymap.h"
+#include "eeprom_mock.h"
+
+extern const uint16_t keymaps[][MATRIX_ROWS][MATRIX_COLS];
+const uint16_t        keymaps[][MATRIX_ROWS][MATRIX_COLS] = {
+    {{KC_A, KC_B, KC_C}, {KC_D, KC_E, KC_F}},
+    {{KC_1, KC_2, KC_3}, {KC_4, KC_5, KC_6}},
+};
+
+void send_string(const char *str) {}
+}
+
+class DynamicKeymap : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        dynamic_keymap_reset();
+        dynamic_keymap_macro_reset();
+        dynamic_keymap_init();
+    }
+};
+
+TEST_F(DynamicKeymap, ResetLoadsKeymapsFromFlash) {
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 0, 0), KC_A);
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 1, 2), KC_F);
+    EXPECT_EQ(dynamic_keymap_get_keycode(1, 0, 1), KC_2);
+    EXPECT_EQ(dynamic_keymap_get_keycode(1, 1, 2), KC_6);
+}
+
+TEST_F(DynamicKeymap, SetKeycodeIsReadBackAndStoredBigEndian) {
+    dynamic_keymap_set_keycode(1, 1, 0, 0x1234);
+    EXPECT_EQ(dynamic_keymap_get_keycode(1, 1, 0), 0x1234);
+
+    uint8_t *address = (uint8_t *)dynamic_keymap_key_to_eeprom_address(1, 1, 0);
+    EXPECT_EQ(eeprom_read_byte(address), 0x12);
+    EXPECT_EQ(eeprom_read_byte(address + 1), 0x34);
+}
+
+TEST_F(DynamicKeymap, SetBufferIsReadBackByKeycode) {
+    uint8_t data[] = {0xAB, 0xCD, 0x00, 0x42};
+    // Starts at the second byte of layer 0, row 1, column 0
+    dynamic_keymap_set_buffer(MATRIX_COLS * 2 + 1, sizeof(data), data);
+
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 1, 0), (KC_D & 0xFF00) | 0xAB);
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 1, 1), 0xCD00);
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 1, 2), 0x4200 | (KC_F & 0x00FF));
+
+    uint8_t readback[sizeof(data)] = {0};
+    dynamic_keymap_get_buffer(MATRIX_COLS * 2 + 1, sizeof(readback), readback);
+    EXPECT_EQ(memcmp(data, readback, sizeof(data)), 0);
+}
+
+TEST_F(DynamicKeymap, OutOfRangeReadReturnsNoKey) {
+    dynamic_keymap_set_keycode(1, 0, 0, KC_Z);
+
+    EXPECT_EQ(dynamic_keymap_get_keycode(DYNAMIC_KEYMAP_LAYER_COUNT, 0, 0), KC_NO);
+    EXPECT_EQ(dynamic_keymap_get_keycode(0xFF, 0xFF, 0xFF), KC_NO);
+    // Would alias layer 1, row 0 if not rejected
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, MATRIX_ROWS, 0), KC_NO);
+    // Would alias row 1, column 0 if not rejected
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 0, MATRIX_COLS), KC_NO);
+}
+
+TEST_F(DynamicKeymap, OutOfRangeWriteIsIgnored) {
+    dynamic_keymap_set_keycode(DYNAMIC_KEYMAP_LAYER_COUNT, 0, 0, KC_Z);
+    dynamic_keymap_set_keycode(0xFF, 0xFF, 0xFF, KC_Z);
+    dynamic_keymap_set_keycode(0, MATRIX_ROWS, 0, KC_Z);
+    dynamic_keymap_set_keycode(0, 0, MATRIX_COLS, KC_Z);
+
+    for (uint8_t layer = 0; layer < DYNAMIC_KEYMAP_LAYER_COUNT; layer++) {
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t column = 0; column < MATRIX_COLS; column++) {
+                EXPECT_EQ(dynamic_keymap_get_keycode(layer, row, column), keymaps[layer][row][column]);
+            }
+        }
+    }
+
+    // The macro buffer directly follows the keymaps in EEPROM
+    uint8_t macros[4] = {0xFF, 0xFF, 0xFF, 0xFF};
+    dynamic_keymap_macro_get_buffer(0, sizeof(macros), macros);
+    for (uint8_t i = 0; i < sizeof(macros); i++) {
+        EXPECT_EQ(macros[i], 0);
+    }
+}
+
+TEST_F(DynamicKeymap, ResetRestoresChangedKeycodes) {
+    dynamic_keymap_set_keycode(0, 0, 0, KC_Z);
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 0, 0), KC_Z);
+
+    dynamic_keymap_reset();
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 0, 0), KC_A);
+}
+
+#ifdef DYNAMIC_KEYMAP_RAM_CACHE
+TEST_F(DynamicKeymap, CachedLookupsDontReadEeprom) {
+    eeprom_mock_reads = 0;
+    for (uint8_t layer = 0; layer < DYNAMIC_KEYMAP_LAYER_COUNT; layer++) {
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t column = 0; column < MATRIX_COLS; column++) {
+                EXPECT_EQ(dynamic_keymap_get_keycode(layer, row, column), keymaps[layer][row][column]);
+            }
+        }
+    }
+    EXPECT_EQ(eeprom_mock_reads, 0);
+}
+
+TEST_F(DynamicKeymap, InitReadsTheKeymapsOnce) {
+    eeprom_mock_reads = 0;
+    dynamic_keymap_init();
+    EXPECT_EQ(eeprom_mock_reads, DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2);
+}
+
+TEST_F(DynamicKeymap, CacheReloadsEepromChanges) {
+    EXPECT_EQ(dynamic_keymap_get_keycode(1, 0, 2), KC_3);
+
+    // Change the keymap behind the cache's back, as an EEPROM erase would
+    uint8_t *address = (uint8_t *)dynamic_keymap_key_to_eeprom_address(1, 0, 2);
+    eeprom_update_byte(address, 0x00);
+    eeprom_update_byte(address + 1, KC_Q);
+    EXPECT_EQ(dynamic_keymap_get_keycode(1, 0, 2), KC_3);
+
+    eeprom_mock_reads = 0;
+    dynamic_keymap_cache_reload();
+    EXPECT_EQ(eeprom_mock_reads, DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2);
+
+    eeprom_mock_reads = 0;
+    EXPECT_EQ(dynamic_keymap_get_keycode(1, 0, 2), KC_Q);
+    EXPECT_EQ(eeprom_mock_reads, 0);
+}
+
+TEST_F(DynamicKeymap, ResetOverwritesStaleCache) {
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 1, 1), KC_E);
+
+    uint8_t *address = (uint8_t *)dynamic_keymap_key_to_eeprom_address(0, 0, 1);
+    eeprom_update_byte(address, 0x00);
+    eeprom_update_byte(address + 1, KC_Q);
+
+    dynamic_keymap_reset();
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 0, 1), KC_B);
+    uint8_t readback[2];
+    dynamic_keymap_get_buffer(2, sizeof(readback), readback);
+    EXPECT_EQ((readback[0] << 8) | readback[1], KC_B);
+}
+#endif
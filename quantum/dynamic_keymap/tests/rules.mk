@@ -0,0 +1,13 @@
+# EEPROM addresses are plain integers cast to pointers, which is only lossless on the 16/32-bit targets
+DYNAMIC_KEYMAP_COMMON_DEFS := -DNO_DEBUG -Wno-int-to-pointer-cast -DEEPROM_CUSTOM -DEEPROM_SIZE=256 -DDYNAMIC_KEYMAP_ENABLE -DMATRIX_ROWS=2 -DMATRIX_COLS=3 -DDYNAMIC_KEYMAP_LAYER_COUNT=2 -DDYNAMIC_KEYMAP_EEPROM_ADDR=0
+
+DYNAMIC_KEYMAP_COMMON_SRC := \
+	$(QUANTUM_PATH)/dynamic_keymap/tests/dynamic_keymap_tests.cpp \
+	$(QUANTUM_PATH)/dynamic_keymap/tests/eeprom_mock.c \
+	$(QUANTUM_PATH)/dynamic_keymap.c
+
+dynamic_keymap_DEFS := $(DYNAMIC_KEYMAP_COMMON_DEFS)
+dynamic_keymap_SRC := $(DYNAMIC_KEYMAP_COMMON_SRC)
+
+dynamic_keymap_cache_DEFS := $(DYNAMIC_KEYMAP_COMMON_DEFS) -DDYNAMIC_KEYMAP_RAM_CACHE
+dynamic_keymap_cache_SRC := $(DYNAMIC_KEYMAP_COMMON_SRC)
@@ -0,0 +1,158 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <string.h>
+#include "input_latency.h"
+#include "matrix.h"
+#include "timer.h"
+#include "print.h"
+#include "debug.h"
+
+#ifndef DEBOUNCE
+#    define DEBOUNCE 5
+#endif
+
+static input_latency_histogram_t histograms[INPUT_LATENCY_STAGES];
+
+/* Time of the first raw change of each key that has not produced a key edge yet, 0 if none.
+ * Bounces within DEBOUNCE of it keep it, so the debounce stage covers the whole bounce. */
+static uint16_t raw_change_time[MATRIX_ROWS][MATRIX_COLS];
+/* Debounce delay of the last key edge of each key, so the total can start at the raw change. */
+static uint8_t debounce_time[MATRIX_ROWS][MATRIX_COLS];
+
+/* Oldest key edge that has been processed but not yet made it into a report, timed from its raw change. */
+static bool     report_pending;
+static uint16_t pending_event_time;
+static uint16_t pending_process_time;
+static uint16_t send_begin_time;
+
+static void input_latency_record(input_latency_stage_t stage, uint16_t elapsed) {
+    // event times are forced odd so they are never zero, which can put them 1ms ahead of the timer
+    if (elapsed > UINT16_MAX / 2) {
+        elapsed = 0;
+    }
+    uint8_t   bucket = elapsed < INPUT_LATENCY_BUCKETS ? elapsed : INPUT_LATENCY_BUCKETS - 1;
+    uint16_t *count  = &histograms[stage].buckets[bucket];
+    if (*count < UINT16_MAX) {
+        (*count)++;
+    }
+}
+
+void input_latency_raw_change(uint8_t row, matrix_row_t raw, matrix_row_t changed) {
+    if (row >= MATRIX_ROWS) {
+        return;
+    }
+    uint16_t     now       = timer_read() | 1;
+    matrix_row_t debounced = matrix_get_row(row);
+    for (uint8_t col = 0; changed && col < MATRIX_COLS; col++, changed >>= 1) {
+        if (!(changed & 1)) {
+            continue;
+        }
+        matrix_row_t col_mask = (matrix_row_t)1 << col;
+        // a change away from the debounced state long after the last one is a new edge,
+        // anything older was a glitch that never made it through debounce
+        if ((raw & col_mask) != (debounced & col_mask) && (!raw_change_time[row][col] || TIMER_DIFF_16(now, raw_change_time[row][col]) > DEBOUNCE)) {
+            raw_change_time[row][col] = now;
+        }
+    }
+}
+
+void input_latency_key_event(keyevent_t *event) {
+    if (IS_NOEVENT(*event) || event->key.row >= MATRIX_ROWS || event->key.col >= MATRIX_COLS) {
+        return;
+    }
+    uint16_t raw_time = raw_change_time[event->key.row][event->key.col];
+    uint16_t elapsed  = 0;
+    if (raw_time) {
+        elapsed = TIMER_DIFF_16(event->time, raw_time);
+        if (elapsed > UINT16_MAX / 2) {
+            elapsed = 0;
+        }
+        input_latency_record(INPUT_LATENCY_DEBOUNCE, elapsed);
+        raw_change_time[event->key.row][event->key.col] = 0;
+    }
+    debounce_time[event->key.row][event->key.col] = elapsed < UINT8_MAX ? elapsed : UINT8_MAX;
+}
+
+void input_latency_process_record(keyrecord_t *record) {
+    if (IS_NOEVENT(record->event)) {
+        return;
+    }
+    uint16_t now = timer_read();
+    input_latency_record(INPUT_LATENCY_PROCESS, TIMER_DIFF_16(now, record->event.time));
+
+    if (!report_pending) {
+        report_pending       = true;
+        pending_event_time   = record->event.time;
+        pending_process_time = now;
+        if (record->event.key.row < MATRIX_ROWS && record->event.key.col < MATRIX_COLS) {
+            pending_event_time -= debounce_time[record->event.key.row][record->event.key.col];
+        }
+    }
+}
+
+void input_latency_send_begin(void) {
+    send_begin_time = timer_read();
+}
+
+void input_latency_send_end(void) {
+    uint16_t now = timer_read();
+    input_latency_record(INPUT_LATENCY_SEND, TIMER_DIFF_16(now, send_begin_time));
+
+    if (report_pending) {
+        input_latency_record(INPUT_LATENCY_REPORT, TIMER_DIFF_16(send_begin_time, pending_process_time));
+        input_latency_record(INPUT_LATENCY_TOTAL, TIMER_DIFF_16(now, pending_event_time));
+        report_pending = false;
+    }
+}
+
+/* Called once per scan, after all key events of the scan were processed. Events that did not
+ * produce a report by now (layer keys, undecided tap-holds) are not measured. */
+void input_latency_task(void) {
+    report_pending = false;
+#if defined(INPUT_LATENCY_PRINT_INTERVAL) && defined(CONSOLE_ENABLE)
+    static uint32_t print_timer = 0;
+    if (timer_elapsed32(print_timer) >= INPUT_LATENCY_PRINT_INTERVAL) {
+        print_timer = timer_read32();
+        input_latency_print();
+    }
+#endif
+}
+
+const input_latency_histogram_t *input_latency_get_histogram(input_latency_stage_t stage) {
+    if (stage >= INPUT_LATENCY_STAGES) {
+        return NULL;
+    }
+    return &histograms[stage];
+}
+
+void input_latency_clear(void) {
+    memset(histograms, 0, sizeof(histograms));
+}
+
+void input_latency_print(void) {
+#ifndef NO_PRINT
+    static const char *const stage_names[INPUT_LATENCY_STAGES] = {"debounce", "process", "report", "send", "total"};
+
+    for (uint8_t stage = 0; stage < INPUT_LATENCY_STAGES; stage++) {
+        uprintf("latency %-8s:", stage_names[stage]);
+        for (uint8_t bucket = 0; bucket < INPUT_LATENCY_BUCKETS; bucket++) {
+            uprintf(" %u", histograms[stage].buckets[bucket]);
+        }
+        uprintf("\n");
+    }
+#endif
+}
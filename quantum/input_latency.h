@@ -0,0 +1,54 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "action.h"
+#include "matrix.h"
+
+#ifndef INPUT_LATENCY_BUCKETS
+#    define INPUT_LATENCY_BUCKETS 16
+#endif
+
+/* Stages of the path from a switch edge to the keyboard report leaving the firmware.
+ * All values are in milliseconds; the last bucket also counts everything above it. */
+typedef enum {
+    INPUT_LATENCY_DEBOUNCE, // raw matrix change -> debounced key edge
+    INPUT_LATENCY_PROCESS,  // debounced key edge -> process_record, includes tapping and combos
+    INPUT_LATENCY_REPORT,   // process_record -> host_keyboard_send
+    INPUT_LATENCY_SEND,     // time spent in the host driver sending the report
+    INPUT_LATENCY_TOTAL,    // raw matrix change -> report sent
+    INPUT_LATENCY_STAGES,
+} input_latency_stage_t;
+
+typedef struct {
+    uint16_t buckets[INPUT_LATENCY_BUCKETS];
+} input_latency_histogram_t;
+
+// hooks called by the input pipeline
+void input_latency_raw_change(uint8_t row, matrix_row_t raw, matrix_row_t changed);
+void input_latency_key_event(keyevent_t *event);
+void input_latency_process_record(keyrecord_t *record);
+void input_latency_send_begin(void);
+void input_latency_send_end(void);
+void input_latency_task(void);
+
+// readout, e.g. from raw_hid_receive()
+const input_latency_histogram_t *input_latency_get_histogram(input_latency_stage_t stage);
+void                             input_latency_clear(void);
+void                             input_latency_print(void);
@@ -108,6 +108,12 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef BLUETOOTH_ENABLE
 #    include "outputselect.h"
 #endif
+#ifdef INPUT_LATENCY_ENABLE
+#    include "input_latency.h"
+#endif
+#ifdef I2C_ASYNC_ENABLE
+#    include "i2c_async.h"
+#endif
 
 static uint32_t last_input_modification_time = 0;
 uint32_t        last_input_activity_time(void) {
@@ -366,6 +372,9 @@ void keyboard_init(void) {
 #ifdef VIA_ENABLE
     via_init();
 #endif
+#ifdef DYNAMIC_KEYMAP_ENABLE
+    dynamic_keymap_init();
+#endif
 #ifdef SPLIT_KEYBOARD
     split_pre_init();
 #endif
@@ -395,6 +404,9 @@ void keyboard_init(void) {
 #ifdef STENO_ENABLE
     steno_init();
 #endif
+#ifdef COMBO_ENABLE
+    combo_init();
+#endif
 #ifdef POINTING_DEVICE_ENABLE
     pointing_device_init();
 #endif
@@ -436,62 +448,121 @@ void switch_events(uint8_t row, uint8_t col, bool pressed) {
 #endif
 }
 
+#ifndef KEY_EVENT_QUEUE_SIZE
+#    define KEY_EVENT_QUEUE_SIZE 16
+#endif
+
+#ifndef QMK_KEYS_PER_SCAN
+#    define QMK_KEYS_PER_SCAN KEY_EVENT_QUEUE_SIZE
+#endif
+
+_Static_assert(KEY_EVENT_QUEUE_SIZE > 0 && KEY_EVENT_QUEUE_SIZE <= 255, "KEY_EVENT_QUEUE_SIZE must be between 1 and 255");
+_Static_assert(QMK_KEYS_PER_SCAN > 0, "QMK_KEYS_PER_SCAN must be greater than 0");
+
+/* Key edges detected by matrix_scan_task, waiting to be handed to action_exec.
+ *
+ * Edges are appended in scan order and stamped with the time of the scan that
+ * detected them, so the queue is always ordered by timestamp. Edges that do not
+ * fit are left unacknowledged in matrix_prev and are picked up by the next scan.
+ */
+static keyevent_t key_event_queue[KEY_EVENT_QUEUE_SIZE];
+static uint8_t    key_event_queue_head  = 0;
+static uint8_t    key_event_queue_count = 0;
+
+static inline bool key_event_queue_full(void) {
+    return key_event_queue_count >= KEY_EVENT_QUEUE_SIZE;
+}
+
+static inline void key_event_enqueue(keyevent_t event) {
+    uint8_t tail = key_event_queue_head + key_event_queue_count;
+    if (tail >= KEY_EVENT_QUEUE_SIZE) tail -= KEY_EVENT_QUEUE_SIZE;
+
+    key_event_queue[tail] = event;
+    key_event_queue_count++;
+}
+
+static inline keyevent_t key_event_dequeue(void) {
+    keyevent_t event = key_event_queue[key_event_queue_head];
+
+    if (++key_event_queue_head >= KEY_EVENT_QUEUE_SIZE) key_event_queue_head = 0;
+    key_event_queue_count--;
+    return event;
+}
+
+/** \brief Collect all changed keys of the current scan into the key event queue
+ *
+ * Returns true if there are edges left in the matrix that did not fit into the queue.
+ */
+static bool matrix_collect_events(matrix_row_t matrix_prev[]) {
+    /* all edges of one scan share its timestamp; time should not be 0 */
+    const uint16_t scan_time = timer_read() | 1;
+
+    for (uint8_t r = 0; r < MATRIX_ROWS; r++) {
+        matrix_row_t matrix_row    = matrix_get_row(r);
+        matrix_row_t matrix_change = matrix_row ^ matrix_prev[r];
+        if (!matrix_change) continue;
+#ifdef MATRIX_HAS_GHOST
+        if (has_ghost_in_row(r, matrix_row)) {
+            continue;
+        }
+#endif
+        if (debug_matrix) matrix_print();
+        matrix_row_t col_mask = 1;
+        for (uint8_t c = 0; c < MATRIX_COLS; c++, col_mask <<= 1) {
+            if (matrix_change & col_mask) {
+                if (key_event_queue_full()) return true;
+
+                keyevent_t event = {.key = (keypos_t){.row = r, .col = c}, .pressed = (matrix_row & col_mask), .time = scan_time};
+#ifdef INPUT_LATENCY_ENABLE
+                input_latency_key_event(&event);
+#endif
+                key_event_enqueue(event);
+                // record a queued key
+                matrix_prev[r] ^= col_mask;
+            }
+        }
+    }
+    return false;
+}
+
 /** \brief Perform scan of keyboard matrix
  *
- * Any detected changes in state are sent out as part of the processing
+ * Any detected changes in state are sent out as part of the processing.
+ * All edges of one scan are queued and up to QMK_KEYS_PER_SCAN of them are
+ * processed per call, oldest first.
  */
 bool matrix_scan_task(void) {
     static matrix_row_t matrix_prev[MATRIX_ROWS];
-    matrix_row_t        matrix_row    = 0;
-    matrix_row_t        matrix_change = 0;
-#ifdef QMK_KEYS_PER_SCAN
-    uint8_t keys_processed = 0;
-#endif
+    uint8_t             keys_processed = 0;
 
     uint8_t matrix_changed = matrix_scan();
     if (matrix_changed) last_matrix_activity_trigger();
 
-    for (uint8_t r = 0; r < MATRIX_ROWS; r++) {
-        matrix_row    = matrix_get_row(r);
-        matrix_change = matrix_row ^ matrix_prev[r];
-        if (matrix_change) {
-#ifdef MATRIX_HAS_GHOST
-            if (has_ghost_in_row(r, matrix_row)) {
-                continue;
-            }
-#endif
-            if (debug_matrix) matrix_print();
-            matrix_row_t col_mask = 1;
-            for (uint8_t c = 0; c < MATRIX_COLS; c++, col_mask <<= 1) {
-                if (matrix_change & col_mask) {
-                    if (should_process_keypress()) {
-                        action_exec((keyevent_t){
-                            .key = (keypos_t){.row = r, .col = c}, .pressed = (matrix_row & col_mask), .time = (timer_read() | 1) /* time should not be 0 */
-                        });
-                    }
-                    // record a processed key
-                    matrix_prev[r] ^= col_mask;
-
-                    switch_events(r, c, (matrix_row & col_mask));
-
-#ifdef QMK_KEYS_PER_SCAN
-                    // only jump out if we have processed "enough" keys.
-                    if (++keys_processed >= QMK_KEYS_PER_SCAN)
-#endif
-                        // process a key per task call
-                        goto MATRIX_LOOP_END;
-                }
-            }
+    bool events_pending = matrix_collect_events(matrix_prev);
+
+    while (key_event_queue_count && keys_processed < QMK_KEYS_PER_SCAN) {
+        keyevent_t event = key_event_dequeue();
+
+        if (should_process_keypress()) {
+            action_exec(event);
+        }
+        switch_events(event.key.row, event.key.col, event.pressed);
+        keys_processed++;
+
+        // make room for edges that did not fit into the queue before
+        if (events_pending && !key_event_queue_count) {
+            events_pending = matrix_collect_events(matrix_prev);
         }
     }
+
     // call with pseudo tick event when no real key event.
-#ifdef QMK_KEYS_PER_SCAN
-    // we can get here with some keys processed now.
-    if (!keys_processed)
-#endif
+    if (!keys_processed) {
         action_exec(TICK);
+    }
 
-MATRIX_LOOP_END:
+#ifdef INPUT_LATENCY_ENABLE
+    input_latency_task();
+#endif
 
     matrix_scan_perf_task();
     return matrix_changed;
@@ -662,5 +733,9 @@ void keyboard_task(void) {
     programmable_button_send();
 #endif
 
+#ifdef I2C_ASYNC_ENABLE
+    i2c_async_task();
+#endif
+
     led_task();
 }
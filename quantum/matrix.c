@@ -21,6 +21,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "matrix.h"
 #include "debounce.h"
 #include "quantum.h"
+#ifdef INPUT_LATENCY_ENABLE
+#    include "input_latency.h"
+#endif
 #ifdef SPLIT_KEYBOARD
 #    include "split_common/split_util.h"
 #    include "split_common/transactions.h"
@@ -99,6 +102,122 @@ static inline uint8_t readMatrixPin(pin_t pin) {
     }
 }
 
+#if defined(MATRIX_READ_BY_PORT) && (defined(DIRECT_PINS) || (defined(MATRIX_COL_PINS) && (DIODE_DIRECTION == COL2ROW)))
+#    define MATRIX_PORT_RUNS
+#    ifdef DIRECT_PINS
+#        define MATRIX_PIN_GROUPS ROWS_PER_HAND
+#    else
+#        define MATRIX_PIN_GROUPS 1
+#    endif
+#    ifndef MATRIX_READ_PORT_COUNT
+#        define MATRIX_READ_PORT_COUNT 8
+#    endif
+
+/* A run of pins on one port whose pads and columns are both consecutive,
+ * so the whole run can be moved into the matrix row with a mask and a shift. */
+typedef struct {
+    uint8_t      port_index;
+    uint8_t      pad;
+    uint8_t      col;
+    uint8_t      length;
+    matrix_row_t mask;
+} matrix_port_run_t;
+
+static port_t            matrix_ports[MATRIX_READ_PORT_COUNT];
+static uint8_t           matrix_port_count;
+static matrix_port_run_t matrix_port_runs[MATRIX_PIN_GROUPS * MATRIX_COLS];
+static uint16_t          matrix_port_run_count;
+static uint16_t          matrix_port_run_start[MATRIX_PIN_GROUPS + 1];
+static bool              matrix_port_runs_valid;
+
+static bool matrix_port_runs_add_group(const pin_t pins[]) {
+    const uint16_t group_start = matrix_port_run_count;
+
+    for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+        pin_t pin = pins[col];
+        if (pin == NO_PIN) {
+            continue;
+        }
+
+        port_t  port = getPinPort(pin);
+        uint8_t pad  = getPinPad(pin);
+
+        uint8_t port_index = 0;
+        while (port_index < matrix_port_count && matrix_ports[port_index] != port) {
+            port_index++;
+        }
+        if (port_index == matrix_port_count) {
+            if (matrix_port_count >= MATRIX_READ_PORT_COUNT) {
+                return false;
+            }
+            matrix_ports[matrix_port_count++] = port;
+        }
+
+        // try to extend an existing run of this group
+        bool extended = false;
+        for (uint16_t i = group_start; i < matrix_port_run_count; i++) {
+            matrix_port_run_t *run = &matrix_port_runs[i];
+            if (run->port_index == port_index && run->pad + run->length == pad && run->col + run->length == col) {
+                run->length++;
+                run->mask = (run->mask << 1) | 1;
+                extended  = true;
+                break;
+            }
+        }
+        if (extended) {
+            continue;
+        }
+
+        // keep the runs of a group ordered by port, so every port is read once
+        uint16_t pos = matrix_port_run_count++;
+        while (pos > group_start && matrix_port_runs[pos - 1].port_index > port_index) {
+            matrix_port_runs[pos] = matrix_port_runs[pos - 1];
+            pos--;
+        }
+        matrix_port_runs[pos] = (matrix_port_run_t){.port_index = port_index, .pad = pad, .col = col, .length = 1, .mask = 1};
+    }
+    return true;
+}
+
+static void matrix_port_runs_init(void) {
+    matrix_port_count      = 0;
+    matrix_port_run_count  = 0;
+    matrix_port_runs_valid = false;
+
+    for (uint8_t group = 0; group < MATRIX_PIN_GROUPS; group++) {
+#    ifdef DIRECT_PINS
+        const pin_t *pins = direct_pins[group];
+#    else
+        const pin_t *pins = col_pins;
+#    endif
+        matrix_port_run_start[group] = matrix_port_run_count;
+        if (!matrix_port_runs_add_group(pins)) {
+            // too many ports, stay with reading pin by pin
+            return;
+        }
+    }
+    matrix_port_run_start[MATRIX_PIN_GROUPS] = matrix_port_run_count;
+    matrix_port_runs_valid                   = true;
+}
+
+/* Reads a group of pins with one register read per port. Pins read low are pressed. */
+static matrix_row_t matrix_read_port_runs(uint8_t group) {
+    matrix_row_t value      = 0;
+    port_data_t  data       = 0;
+    uint8_t      port_index = UINT8_MAX;
+
+    for (uint16_t i = matrix_port_run_start[group]; i < matrix_port_run_start[group + 1]; i++) {
+        const matrix_port_run_t *run = &matrix_port_runs[i];
+        if (run->port_index != port_index) {
+            port_index = run->port_index;
+            data       = ~readPort(matrix_ports[port_index]);
+        }
+        value |= ((matrix_row_t)(data >> run->pad) & run->mask) << run->col;
+    }
+    return value;
+}
+#endif
+
 // matrix code
 
 #ifdef DIRECT_PINS
@@ -118,11 +237,18 @@ __attribute__((weak)) void matrix_read_cols_on_row(matrix_row_t current_matrix[]
     // Start with a clear matrix row
     matrix_row_t current_row_value = 0;
 
-    matrix_row_t row_shifter = MATRIX_ROW_SHIFTER;
-    for (uint8_t col_index = 0; col_index < MATRIX_COLS; col_index++, row_shifter <<= 1) {
-        pin_t pin = direct_pins[current_row][col_index];
-        if (pin != NO_PIN) {
-            current_row_value |= readPin(pin) ? 0 : row_shifter;
+#    ifdef MATRIX_PORT_RUNS
+    if (matrix_port_runs_valid) {
+        current_row_value = matrix_read_port_runs(current_row);
+    } else
+#    endif
+    {
+        matrix_row_t row_shifter = MATRIX_ROW_SHIFTER;
+        for (uint8_t col_index = 0; col_index < MATRIX_COLS; col_index++, row_shifter <<= 1) {
+            pin_t pin = direct_pins[current_row][col_index];
+            if (pin != NO_PIN) {
+                current_row_value |= readPin(pin) ? 0 : row_shifter;
+            }
         }
     }
 
@@ -178,13 +304,21 @@ __attribute__((weak)) void matrix_read_cols_on_row(matrix_row_t current_matrix[]
     }
     matrix_output_select_delay();
 
-    // For each col...
-    matrix_row_t row_shifter = MATRIX_ROW_SHIFTER;
-    for (uint8_t col_index = 0; col_index < MATRIX_COLS; col_index++, row_shifter <<= 1) {
-        uint8_t pin_state = readMatrixPin(col_pins[col_index]);
-
-        // Populate the matrix row with the state of the col pin
-        current_row_value |= pin_state ? 0 : row_shifter;
+#            ifdef MATRIX_PORT_RUNS
+    if (matrix_port_runs_valid) {
+        // Read all cols, one port at a time
+        current_row_value = matrix_read_port_runs(0);
+    } else
+#            endif
+    {
+        // For each col...
+        matrix_row_t row_shifter = MATRIX_ROW_SHIFTER;
+        for (uint8_t col_index = 0; col_index < MATRIX_COLS; col_index++, row_shifter <<= 1) {
+            uint8_t pin_state = readMatrixPin(col_pins[col_index]);
+
+            // Populate the matrix row with the state of the col pin
+            current_row_value |= pin_state ? 0 : row_shifter;
+        }
     }
 
     // Unselect row
@@ -297,6 +431,10 @@ void matrix_init(void) {
     thatHand = ROWS_PER_HAND - thisHand;
 #endif
 
+#ifdef MATRIX_PORT_RUNS
+    matrix_port_runs_init();
+#endif
+
     // initialize key pins
     matrix_init_pins();
 
@@ -334,6 +472,19 @@ uint8_t matrix_scan(void) {
 #endif
 
     bool changed = memcmp(raw_matrix, curr_matrix, sizeof(curr_matrix)) != 0;
+#ifdef INPUT_LATENCY_ENABLE
+    if (changed) {
+        for (uint8_t row = 0; row < ROWS_PER_HAND; row++) {
+            if (raw_matrix[row] != curr_matrix[row]) {
+#    ifdef SPLIT_KEYBOARD
+                input_latency_raw_change(thisHand + row, curr_matrix[row], raw_matrix[row] ^ curr_matrix[row]);
+#    else
+                input_latency_raw_change(row, curr_matrix[row], raw_matrix[row] ^ curr_matrix[row]);
+#    endif
+            }
+        }
+    }
+#endif
     if (changed) memcpy(raw_matrix, curr_matrix, sizeof(curr_matrix));
 
 #ifdef SPLIT_KEYBOARD
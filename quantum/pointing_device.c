@@ -56,6 +56,48 @@ uint16_t pointing_device_get_shared_cpi(void) {
     return shared_cpi;
 }
 
+static int16_t shared_motion_x = 0;
+static int16_t shared_motion_y = 0;
+static int16_t shared_motion_v = 0;
+static int16_t shared_motion_h = 0;
+
+static int16_t shared_motion_add(int16_t residue, int16_t delta) {
+    int32_t sum = (int32_t)residue + delta;
+    return sum > INT16_MAX ? INT16_MAX : (sum < INT16_MIN ? INT16_MIN : sum);
+}
+
+static int8_t shared_motion_take(int16_t *residue) {
+    int16_t step = *residue > 127 ? 127 : (*residue < -127 ? -127 : *residue);
+    *residue -= step;
+    return step;
+}
+
+/**
+ * @brief Adds motion from the other side to the shared report
+ *
+ * Motion is accumulated until the pointing device task picks it up, anything beyond what a single report can
+ * carry is kept for the following reports.
+ *
+ * NOTE : Only available when using SPLIT_POINTING_ENABLE
+ *
+ * @param[in] buttons current button state
+ * @param[in] x, y, v, h motion since the last call
+ */
+void pointing_device_add_shared_motion(uint8_t buttons, int16_t x, int16_t y, int16_t v, int16_t h) {
+    shared_mouse_report.buttons = buttons;
+    shared_motion_x             = shared_motion_add(shared_motion_x, x);
+    shared_motion_y             = shared_motion_add(shared_motion_y, y);
+    shared_motion_v             = shared_motion_add(shared_motion_v, v);
+    shared_motion_h             = shared_motion_add(shared_motion_h, h);
+}
+
+static void pointing_device_take_shared_motion(void) {
+    shared_mouse_report.x = shared_motion_take(&shared_motion_x);
+    shared_mouse_report.y = shared_motion_take(&shared_motion_y);
+    shared_mouse_report.v = shared_motion_take(&shared_motion_v);
+    shared_mouse_report.h = shared_motion_take(&shared_motion_h);
+}
+
 #    if defined(POINTING_DEVICE_LEFT)
 #        define POINTING_DEVICE_THIS_SIDE is_keyboard_left()
 #    elif defined(POINTING_DEVICE_RIGHT)
@@ -244,6 +286,7 @@ __attribute__((weak)) void pointing_device_task(void) {
 #endif
 
 #if defined(SPLIT_POINTING_ENABLE)
+    pointing_device_take_shared_motion();
 #    if defined(POINTING_DEVICE_COMBINED)
         static uint8_t old_buttons = 0;
     local_mouse_report.buttons = old_buttons;
@@ -93,6 +93,7 @@ report_mouse_t pointing_device_adjust_by_defines(report_mouse_t mouse_report);
 
 #if defined(SPLIT_POINTING_ENABLE)
 void     pointing_device_set_shared_report(report_mouse_t report);
+void     pointing_device_add_shared_motion(uint8_t buttons, int16_t x, int16_t y, int16_t v, int16_t h);
 uint16_t pointing_device_get_shared_cpi(void);
 #    if !defined(POINTING_DEVICE_TASK_THROTTLE_MS)
 #        define POINTING_DEVICE_TASK_THROTTLE_MS 1
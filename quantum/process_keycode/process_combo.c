@@ -14,6 +14,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <string.h>
 #include "print.h"
 #include "process_combo.h"
 #include "action_tapping.h"
@@ -81,6 +82,7 @@ static queued_record_t key_buffer[COMBO_KEY_BUFFER_LENGTH];
 
 typedef struct {
     uint16_t combo_index;
+    uint16_t key_signature;
 } queued_combo_t;
 static uint8_t        combo_buffer_write = 0;
 static uint8_t        combo_buffer_read  = 0;
@@ -90,6 +92,28 @@ static queued_combo_t combo_buffer[COMBO_BUFFER_LENGTH];
 
 #define COMBO_KEY_POS ((keypos_t){.col = 254, .row = 254})
 
+/* Set whenever a combo's state may have changed, so clear_combos() can skip
+ * walking all combos on events that did not touch any of them. */
+static bool combo_state_dirty = false;
+
+#ifdef COMBO_INDEX_LENGTH
+/* Keycode -> combo lookup table, sorted by keycode and then combo index.
+ * Built by combo_init(), and rebuilt when COMBO_LEN changes. If the combos
+ * don't fit, process_combo() falls back to checking every combo. */
+typedef struct {
+    uint16_t keycode;
+    uint16_t combo_index;
+    uint8_t  key_index;
+    uint8_t  key_count;
+} combo_index_entry_t;
+
+static combo_index_entry_t combo_index[COMBO_INDEX_LENGTH];
+static uint16_t            combo_index_size      = 0;
+static uint16_t            combo_index_combo_len = 0;
+static bool                combo_index_built     = false;
+static bool                combo_index_valid     = false;
+#endif
+
 #ifndef EXTRA_SHORT_COMBOS
 /* flags are their own elements in combo_t struct. */
 #    define COMBO_ACTIVE(combo) (combo->active)
@@ -138,6 +162,7 @@ static queued_combo_t combo_buffer[COMBO_BUFFER_LENGTH];
 #endif
 
 static inline void release_combo(uint16_t combo_index, combo_t *combo) {
+    combo_state_dirty = true;
     if (combo->keycode) {
         keyrecord_t record = {
             .event =
@@ -195,6 +220,10 @@ static inline uint16_t _get_combo_term(uint16_t combo_index, combo_t *combo) {
 void clear_combos(void) {
     uint16_t index = 0;
     longest_term   = 0;
+    if (!combo_state_dirty) {
+        return;
+    }
+    combo_state_dirty = false;
     for (index = 0; index < COMBO_LEN; ++index) {
         combo_t *combo = &key_combos[index];
         if (!COMBO_ACTIVE(combo)) {
@@ -248,7 +277,6 @@ static inline void dump_key_buffer(void) {
     key_buffer_next = key_buffer_size = 0;
 }
 
-#define NO_COMBO_KEYS_ARE_DOWN (0 == COMBO_STATE(combo))
 #define ALL_COMBO_KEYS_ARE_DOWN(state, key_count) (((1 << key_count) - 1) == state)
 #define ONLY_ONE_KEY_IS_DOWN(state) !(state & (state - 1))
 #define KEY_NOT_YET_RELEASED(state, key_index) ((1 << key_index) & state)
@@ -280,6 +308,7 @@ void drop_combo_from_buffer(uint16_t combo_index) {
         if (qcombo->combo_index == combo_index) {
             combo_t *combo = &key_combos[combo_index];
             DISABLE_COMBO(combo);
+            combo_state_dirty = true;
 
             if (i == combo_buffer_read) {
                 INCREMENT_MOD(combo_buffer_read);
@@ -297,6 +326,7 @@ void apply_combo(uint16_t combo_index, combo_t *combo) {
     if (COMBO_DISABLED(combo)) {
         return;
     }
+    combo_state_dirty = true;
 
     // state to check against so we find the last key of the combo from the buffer
 #if defined(EXTRA_EXTRA_LONG_COMBOS)
@@ -383,6 +413,112 @@ combo_t *overlaps(combo_t *combo1, combo_t *combo2) {
     return combo1;
 }
 
+static inline uint16_t combo_key_signature(combo_t *combo) {
+    /* One bit per hashed keycode. Combos whose signatures don't intersect
+     * can't overlap, which lets most overlap checks skip overlaps(). */
+    uint16_t signature = 0;
+    uint16_t key;
+    for (uint8_t idx = 0; (key = pgm_read_word(&combo->keys[idx])) != COMBO_END; idx++) {
+        signature |= 1U << ((key ^ (key >> 4) ^ (key >> 8)) & 0xF);
+    }
+    return signature;
+}
+
+#ifdef COMBO_INDEX_LENGTH
+static inline bool combo_index_entry_less(combo_index_entry_t *a, combo_index_entry_t *b) {
+    return a->keycode < b->keycode || (a->keycode == b->keycode && a->combo_index < b->combo_index);
+}
+
+static void combo_index_sift_down(uint16_t root, uint16_t size) {
+    for (;;) {
+        uint16_t child = 2 * root + 1;
+        if (child >= size) {
+            return;
+        }
+        if (child + 1 < size && combo_index_entry_less(&combo_index[child], &combo_index[child + 1])) {
+            child++;
+        }
+        if (!combo_index_entry_less(&combo_index[root], &combo_index[child])) {
+            return;
+        }
+        combo_index_entry_t tmp = combo_index[root];
+        combo_index[root]       = combo_index[child];
+        combo_index[child]      = tmp;
+        root                    = child;
+    }
+}
+
+/* Heapsort, O(n log n) without a second buffer the size of the index. */
+static void combo_index_sort(void) {
+    for (uint16_t i = combo_index_size / 2; i-- > 0;) {
+        combo_index_sift_down(i, combo_index_size);
+    }
+    for (uint16_t end = combo_index_size; end-- > 1;) {
+        combo_index_entry_t tmp = combo_index[0];
+        combo_index[0]          = combo_index[end];
+        combo_index[end]        = tmp;
+        combo_index_sift_down(0, end);
+    }
+}
+
+static void combo_index_build(void) {
+    combo_index_size      = 0;
+    combo_index_combo_len = COMBO_LEN;
+    combo_index_built     = true;
+    combo_index_valid     = true;
+
+    /* Collect the entries in combo order, then sort them by keycode. */
+    for (uint16_t idx = 0; idx < COMBO_LEN; ++idx) {
+        const uint16_t *keys        = key_combos[idx].keys;
+        uint16_t        combo_start = combo_index_size;
+        uint8_t         key_count   = 0;
+        while (pgm_read_word(&keys[key_count]) != COMBO_END) {
+            key_count++;
+        }
+
+        for (uint8_t key_index = 0; key_index < key_count; key_index++) {
+            uint16_t keycode = pgm_read_word(&keys[key_index]);
+
+            /* keycode appears twice in this combo, the last one wins */
+            uint16_t pos = combo_start;
+            while (pos < combo_index_size && combo_index[pos].keycode != keycode) {
+                pos++;
+            }
+            if (pos < combo_index_size) {
+                combo_index[pos].key_index = key_index;
+                continue;
+            }
+            if (combo_index_size >= COMBO_INDEX_LENGTH) {
+                combo_index_valid = false;
+                return;
+            }
+            combo_index[combo_index_size++] = (combo_index_entry_t){
+                .keycode     = keycode,
+                .combo_index = idx,
+                .key_index   = key_index,
+                .key_count   = key_count,
+            };
+        }
+    }
+
+    combo_index_sort();
+}
+
+/* Returns the position of the first entry for keycode, or combo_index_size if there is none. */
+static uint16_t combo_index_find(uint16_t keycode) {
+    uint16_t lo = 0, hi = combo_index_size;
+    while (lo < hi) {
+        uint16_t mid = lo + (hi - lo) / 2;
+        if (combo_index[mid].keycode < keycode) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+#endif
+
 #if defined(COMBO_MUST_PRESS_IN_ORDER) || defined(COMBO_MUST_PRESS_IN_ORDER_PER_COMBO)
 static bool keys_pressed_in_order(uint16_t combo_index, combo_t *combo, uint16_t key_index, uint16_t keycode, keyrecord_t *record) {
 #    ifdef COMBO_MUST_PRESS_IN_ORDER_PER_COMBO
@@ -405,15 +541,8 @@ static bool keys_pressed_in_order(uint16_t combo_index, combo_t *combo, uint16_t
 }
 #endif
 
-static bool process_single_combo(combo_t *combo, uint16_t keycode, keyrecord_t *record, uint16_t combo_index) {
-    uint8_t  key_count = 0;
-    uint16_t key_index = -1;
-    _find_key_index_and_count(combo->keys, keycode, &key_index, &key_count);
-
-    /* Continue processing if key isn't part of current combo. */
-    if (-1 == (int16_t)key_index) {
-        return false;
-    }
+static bool process_combo_key(combo_t *combo, uint16_t keycode, keyrecord_t *record, uint16_t combo_index, uint16_t key_index, uint8_t key_count) {
+    combo_state_dirty = true;
 
     bool key_is_part_of_combo = (!COMBO_DISABLED(combo) && is_combo_enabled()
 #if defined(COMBO_MUST_PRESS_IN_ORDER) || defined(COMBO_MUST_PRESS_IN_ORDER_PER_COMBO)
@@ -446,11 +575,18 @@ static bool process_single_combo(combo_t *combo, uint16_t keycode, keyrecord_t *
             {
 
                 // disable readied combos that overlap with this combo
-                combo_t *drop = NULL;
+                combo_t *drop          = NULL;
+                uint16_t key_signature = combo_key_signature(combo);
                 for (uint8_t combo_buffer_i = combo_buffer_read; combo_buffer_i != combo_buffer_write; INCREMENT_MOD(combo_buffer_i)) {
                     queued_combo_t *qcombo         = &combo_buffer[combo_buffer_i];
                     combo_t *       buffered_combo = &key_combos[qcombo->combo_index];
 
+                    if (!(qcombo->key_signature & key_signature)) {
+                        // no key in common
+                        drop = NULL;
+                        continue;
+                    }
+
                     if ((drop = overlaps(buffered_combo, combo))) {
                         DISABLE_COMBO(drop);
                         if (drop == combo) {
@@ -467,7 +603,8 @@ static bool process_single_combo(combo_t *combo, uint16_t keycode, keyrecord_t *
                 if (drop != combo) {
                     // save this combo to buffer
                     combo_buffer[combo_buffer_write] = (queued_combo_t){
-                        .combo_index = combo_index,
+                        .combo_index   = combo_index,
+                        .key_signature = key_signature,
                     };
                     INCREMENT_MOD(combo_buffer_write);
 
@@ -525,9 +662,21 @@ static bool process_single_combo(combo_t *combo, uint16_t keycode, keyrecord_t *
     return key_is_part_of_combo;
 }
 
+static bool process_single_combo(combo_t *combo, uint16_t keycode, keyrecord_t *record, uint16_t combo_index) {
+    uint8_t  key_count = 0;
+    uint16_t key_index = -1;
+    _find_key_index_and_count(combo->keys, keycode, &key_index, &key_count);
+
+    /* Continue processing if key isn't part of current combo. */
+    if (-1 == (int16_t)key_index) {
+        return false;
+    }
+
+    return process_combo_key(combo, keycode, record, combo_index, key_index, key_count);
+}
+
 bool process_combo(uint16_t keycode, keyrecord_t *record) {
-    bool is_combo_key          = false;
-    bool no_combo_keys_pressed = true;
+    bool is_combo_key = false;
 
     if (keycode == CMB_ON && record->event.pressed) {
         combo_enable();
@@ -549,10 +698,25 @@ bool process_combo(uint16_t keycode, keyrecord_t *record) {
     keycode = keymap_key_to_keycode(COMBO_ONLY_FROM_LAYER, record->event.key);
 #endif
 
-    for (uint16_t idx = 0; idx < COMBO_LEN; ++idx) {
-        combo_t *combo = &key_combos[idx];
-        is_combo_key |= process_single_combo(combo, keycode, record, idx);
-        no_combo_keys_pressed = no_combo_keys_pressed && (NO_COMBO_KEYS_ARE_DOWN || COMBO_ACTIVE(combo) || COMBO_DISABLED(combo));
+#ifdef COMBO_INDEX_LENGTH
+    /* COMBO_LEN may have been changed after combo_init(), e.g. from keyboard_post_init_user() */
+    if (!combo_index_built || combo_index_combo_len != COMBO_LEN) {
+        combo_index_build();
+    }
+
+    if (combo_index_valid) {
+        /* Only visit the combos that contain this keycode. */
+        for (uint16_t i = combo_index_find(keycode); i < combo_index_size && combo_index[i].keycode == keycode; ++i) {
+            combo_index_entry_t *entry = &combo_index[i];
+            is_combo_key |= process_combo_key(&key_combos[entry->combo_index], keycode, record, entry->combo_index, entry->key_index, entry->key_count);
+        }
+    } else
+#endif
+    {
+        for (uint16_t idx = 0; idx < COMBO_LEN; ++idx) {
+            combo_t *combo = &key_combos[idx];
+            is_combo_key |= process_single_combo(combo, keycode, record, idx);
+        }
     }
 
     if (record->event.pressed && is_combo_key) {
@@ -590,6 +754,12 @@ bool process_combo(uint16_t keycode, keyrecord_t *record) {
     return !is_combo_key;
 }
 
+void combo_init(void) {
+#ifdef COMBO_INDEX_LENGTH
+    combo_index_build();
+#endif
+}
+
 void combo_task(void) {
     if (!b_combo_enable) {
         return;
@@ -3,6 +3,8 @@
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
 
 typedef HSV (*reactive_splash_f)(HSV hsv, int16_t dx, int16_t dy, uint8_t dist, uint16_t tick);
+// Narrows down the distances from a hit at which the effect shows, returns false once it shows nowhere
+typedef bool (*reactive_splash_range_f)(uint16_t tick, uint8_t* inner, uint8_t* outer);
 
 bool effect_runner_reactive_splash(uint8_t start, effect_params_t* params, reactive_splash_f effect_func) {
     RGB_MATRIX_USE_LIMITS(led_min, led_max);
@@ -26,4 +28,117 @@ bool effect_runner_reactive_splash(uint8_t start, effect_params_t* params, react
     return rgb_matrix_check_finished_leds(led_max);
 }
 
+#    ifdef RGB_MATRIX_REACTIVE_SPLASH_ENABLED
+// The LEDs, bucketed into a grid of cells 32 units across, indexed by reactive_splash_grid_start
+#        define REACTIVE_SPLASH_GRID_SHIFT 5
+#        define REACTIVE_SPLASH_GRID_SIZE (256 >> REACTIVE_SPLASH_GRID_SHIFT)
+#        define REACTIVE_SPLASH_GRID_CELLS (REACTIVE_SPLASH_GRID_SIZE * REACTIVE_SPLASH_GRID_SIZE)
+
+static uint8_t reactive_splash_grid_start[REACTIVE_SPLASH_GRID_CELLS + 1];
+static uint8_t reactive_splash_grid_leds[DRIVER_LED_TOTAL];
+
+static uint8_t reactive_splash_grid_cell(uint8_t x, uint8_t y) {
+    return (y >> REACTIVE_SPLASH_GRID_SHIFT) * REACTIVE_SPLASH_GRID_SIZE + (x >> REACTIVE_SPLASH_GRID_SHIFT);
+}
+
+void reactive_splash_grid_init(void) {
+    // Counting sort by cell, leaving the start of each cell in reactive_splash_grid_start
+    memset(reactive_splash_grid_start, 0, sizeof(reactive_splash_grid_start));
+    for (uint8_t i = 0; i < DRIVER_LED_TOTAL; i++) {
+        reactive_splash_grid_start[reactive_splash_grid_cell(g_led_config.point[i].x, g_led_config.point[i].y) + 1]++;
+    }
+    for (uint8_t cell = 0; cell < REACTIVE_SPLASH_GRID_CELLS; cell++) {
+        reactive_splash_grid_start[cell + 1] += reactive_splash_grid_start[cell];
+    }
+    for (uint8_t i = 0; i < DRIVER_LED_TOTAL; i++) {
+        uint8_t cell = reactive_splash_grid_cell(g_led_config.point[i].x, g_led_config.point[i].y);
+        reactive_splash_grid_leds[reactive_splash_grid_start[cell]++] = i;
+    }
+    // Filling each cell moved its start up to the next cell's
+    for (uint8_t cell = REACTIVE_SPLASH_GRID_CELLS; cell > 0; cell--) {
+        reactive_splash_grid_start[cell] = reactive_splash_grid_start[cell - 1];
+    }
+    reactive_splash_grid_start[0] = 0;
+}
+
+// The hits' ranges, and the LEDs they might reach, worked out once per frame
+static uint8_t  reactive_splash_reached[(DRIVER_LED_TOTAL + 7) / 8];
+static bool     reactive_splash_live[LED_HITS_TO_REMEMBER];
+static uint16_t reactive_splash_tick[LED_HITS_TO_REMEMBER];
+static uint8_t  reactive_splash_outer[LED_HITS_TO_REMEMBER];
+static uint16_t reactive_splash_inner_sq[LED_HITS_TO_REMEMBER];
+static uint32_t reactive_splash_outer_sq[LED_HITS_TO_REMEMBER]; // just past the outer range, (outer + 1)^2
+
+static void reactive_splash_prepare(uint8_t start, uint8_t count, reactive_splash_range_f range_func) {
+    memset(reactive_splash_reached, 0, sizeof(reactive_splash_reached));
+    for (uint8_t j = start; j < count; j++) {
+        uint8_t inner;
+        uint8_t outer;
+        reactive_splash_tick[j] = scale16by8(g_last_hit_tracker.tick[j], qadd8(rgb_matrix_config.speed, 1));
+        reactive_splash_live[j] = range_func(reactive_splash_tick[j], &inner, &outer);
+        if (!reactive_splash_live[j]) continue;
+        // Compared against the squared distance, so that LEDs out of range don't need a square root
+        reactive_splash_outer[j]    = outer;
+        reactive_splash_inner_sq[j] = inner * inner;
+        reactive_splash_outer_sq[j] = (outer + 1) * (outer + 1);
+
+        // Mark the LEDs in every cell overlapping the box around the hit's outer range
+        uint8_t x      = g_last_hit_tracker.x[j];
+        uint8_t y      = g_last_hit_tracker.y[j];
+        uint8_t cell_x = qsub8(x, outer) >> REACTIVE_SPLASH_GRID_SHIFT;
+        uint8_t last_x = qadd8(x, outer) >> REACTIVE_SPLASH_GRID_SHIFT;
+        uint8_t cell_y = qsub8(y, outer) >> REACTIVE_SPLASH_GRID_SHIFT;
+        uint8_t last_y = qadd8(y, outer) >> REACTIVE_SPLASH_GRID_SHIFT;
+        for (uint8_t cy = cell_y; cy <= last_y; cy++) {
+            for (uint8_t cx = cell_x; cx <= last_x; cx++) {
+                uint8_t cell = cy * REACTIVE_SPLASH_GRID_SIZE + cx;
+                for (uint8_t k = reactive_splash_grid_start[cell]; k < reactive_splash_grid_start[cell + 1]; k++) {
+                    uint8_t led = reactive_splash_grid_leds[k];
+                    reactive_splash_reached[led / 8] |= 1 << (led % 8);
+                }
+            }
+        }
+    }
+}
+
+// Like effect_runner_reactive_splash, but only evaluates hits at the LEDs within their range
+bool effect_runner_reactive_splash_culled(uint8_t start, effect_params_t* params, reactive_splash_f effect_func, reactive_splash_range_f range_func) {
+    RGB_MATRIX_USE_LIMITS(led_min, led_max);
+
+    // The hit tracker only changes between frames
+    uint8_t count = g_last_hit_tracker.count;
+    if (params->iter == 0) {
+        reactive_splash_prepare(start, count, range_func);
+    }
+
+    HSV unlit = rgb_matrix_config.hsv;
+    unlit.v   = 0;
+    RGB dark  = rgb_matrix_hsv_to_rgb(unlit);
+    for (uint8_t i = led_min; i < led_max; i++) {
+        RGB_MATRIX_TEST_LED_FLAGS();
+        if (!(reactive_splash_reached[i / 8] & (1 << (i % 8)))) {
+            rgb_matrix_set_color(i, dark.r, dark.g, dark.b);
+            continue;
+        }
+        HSV hsv = unlit;
+        for (uint8_t j = start; j < count; j++) {
+            // The newest hit is always evaluated, as effects like NEXUS take the hue from it
+            bool newest = j == count - 1;
+            if (!reactive_splash_live[j] && !newest) continue;
+            int16_t dx    = g_led_config.point[i].x - g_last_hit_tracker.x[j];
+            int16_t dy    = g_led_config.point[i].y - g_last_hit_tracker.y[j];
+            int16_t outer = reactive_splash_outer[j];
+            if (!newest && (dx > outer || dx < -outer || dy > outer || dy < -outer)) continue;
+            uint16_t dist_sq = dx * dx + dy * dy;
+            if (!newest && (dist_sq < reactive_splash_inner_sq[j] || dist_sq >= reactive_splash_outer_sq[j])) continue;
+            hsv = effect_func(hsv, dx, dy, sqrt16(dist_sq), reactive_splash_tick[j]);
+        }
+        hsv.v   = scale8(hsv.v, rgb_matrix_config.hsv.v);
+        RGB rgb = rgb_matrix_hsv_to_rgb(hsv);
+        rgb_matrix_set_color(i, rgb.r, rgb.g, rgb.b);
+    }
+    return rgb_matrix_check_finished_leds(led_max);
+}
+#    endif // RGB_MATRIX_REACTIVE_SPLASH_ENABLED
+
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
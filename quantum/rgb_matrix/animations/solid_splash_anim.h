@@ -18,15 +18,23 @@ HSV SOLID_SPLASH_math(HSV hsv, int16_t dx, int16_t dy, uint8_t dist, uint16_t ti
     return hsv;
 }
 
+bool SOLID_SPLASH_range(uint16_t tick, uint8_t* inner, uint8_t* outer) {
+    // The wave front is at dist == tick, and fades out over the 255 units behind it
+    if (tick > 254 + 255) return false;
+    *inner = tick > 254 ? tick - 254 : 0;
+    *outer = tick > 255 ? 255 : tick;
+    return true;
+}
+
 #            ifdef ENABLE_RGB_MATRIX_SOLID_SPLASH
 bool SOLID_SPLASH(effect_params_t* params) {
-    return effect_runner_reactive_splash(qsub8(g_last_hit_tracker.count, 1), params, &SOLID_SPLASH_math);
+    return effect_runner_reactive_splash_culled(qsub8(g_last_hit_tracker.count, 1), params, &SOLID_SPLASH_math, &SOLID_SPLASH_range);
 }
 #            endif
 
 #            ifdef ENABLE_RGB_MATRIX_SOLID_MULTISPLASH
 bool SOLID_MULTISPLASH(effect_params_t* params) {
-    return effect_runner_reactive_splash(0, params, &SOLID_SPLASH_math);
+    return effect_runner_reactive_splash_culled(0, params, &SOLID_SPLASH_math, &SOLID_SPLASH_range);
 }
 #            endif
 
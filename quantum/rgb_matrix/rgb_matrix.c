@@ -119,6 +119,9 @@ uint8_t g_rgb_frame_buffer[MATRIX_ROWS][MATRIX_COLS] = {{0}};
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
 last_hit_t g_last_hit_tracker;
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
+#ifdef RGB_MATRIX_GEOMETRY_CACHE
+led_geometry_t g_led_geometry[DRIVER_LED_TOTAL];
+#endif // RGB_MATRIX_GEOMETRY_CACHE
 
 // internals
 static bool            suspend_state     = false;
@@ -141,6 +144,52 @@ static last_hit_t last_hit_buffer;
 const uint8_t k_rgb_matrix_split[2] = RGB_MATRIX_SPLIT;
 #endif
 
+// lockstep frame clock, both halves render from it instead of the sync timer
+#ifdef RGB_MATRIX_SPLIT_LOCKSTEP
+#    ifndef RGB_MATRIX_SPLIT
+#        error "RGB_MATRIX_SPLIT_LOCKSTEP requires RGB_MATRIX_SPLIT"
+#    endif
+static int32_t rgb_lockstep_offset = 0;
+#    ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
+static rgb_matrix_lockstep_t rgb_lockstep_hits;
+#    endif // RGB_MATRIX_KEYREACTIVE_ENABLED
+
+static inline uint32_t rgb_clock_read32(void) {
+    return timer_read32() + rgb_lockstep_offset;
+}
+#else
+#    define rgb_clock_read32() sync_timer_read32()
+#endif // RGB_MATRIX_SPLIT_LOCKSTEP
+
+// render budget, the LEDs rendered per call are sized from the measured cost of the effect
+#ifdef RGB_MATRIX_RENDER_BUDGET_US
+#    if RGB_MATRIX_LED_PROCESS_LIMIT > 0 && RGB_MATRIX_LED_PROCESS_LIMIT < DRIVER_LED_TOTAL
+#        define RGB_RENDER_INITIAL_CHUNK (RGB_MATRIX_LED_PROCESS_LIMIT)
+#    else
+#        define RGB_RENDER_INITIAL_CHUNK DRIVER_LED_TOTAL
+#    endif
+#    ifdef PROTOCOL_CHIBIOS
+#        include <ch.h>
+#        if PORT_SUPPORTS_RT == TRUE
+// Time render calls with the cycle counter behind the ChibiOS realtime counter
+#            define RGB_RENDER_CLOCK_REALTIME
+#            ifndef RGB_MATRIX_RENDER_CLOCK_PRECISE
+#                define RGB_MATRIX_RENDER_CLOCK_PRECISE
+#            endif
+#        endif
+#    endif
+static uint8_t                   rgb_render_chunk      = RGB_RENDER_INITIAL_CHUNK;
+static uint8_t                   rgb_render_next_led   = 0;
+static uint8_t                   rgb_render_last_led   = DRIVER_LED_TOTAL;
+static uint16_t                  rgb_render_effect     = UINT16_MAX;
+static uint32_t                  rgb_render_call_start = 0;
+static uint32_t                  rgb_render_frame_us   = 0;
+static uint16_t                  rgb_render_frame_leds = 0;
+static uint16_t                  rgb_render_fps_frames = 0;
+static uint32_t                  rgb_render_fps_timer  = 0;
+static rgb_matrix_render_stats_t rgb_render_stats      = {0};
+#endif // RGB_MATRIX_RENDER_BUDGET_US
+
 EECONFIG_DEBOUNCE_HELPER(rgb_matrix, EECONFIG_RGB_MATRIX, rgb_matrix_config);
 
 void eeconfig_update_rgb_matrix(void) {
@@ -209,6 +258,27 @@ void rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
 #endif
 }
 
+#ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
+static void rgb_matrix_add_hits(const uint8_t led[], uint8_t led_count, uint16_t tick) {
+    if (last_hit_buffer.count + led_count > LED_HITS_TO_REMEMBER) {
+        memcpy(&last_hit_buffer.x[0], &last_hit_buffer.x[led_count], LED_HITS_TO_REMEMBER - led_count);
+        memcpy(&last_hit_buffer.y[0], &last_hit_buffer.y[led_count], LED_HITS_TO_REMEMBER - led_count);
+        memcpy(&last_hit_buffer.tick[0], &last_hit_buffer.tick[led_count], (LED_HITS_TO_REMEMBER - led_count) * 2); // 16 bit
+        memcpy(&last_hit_buffer.index[0], &last_hit_buffer.index[led_count], LED_HITS_TO_REMEMBER - led_count);
+        last_hit_buffer.count = LED_HITS_TO_REMEMBER - led_count;
+    }
+
+    for (uint8_t i = 0; i < led_count; i++) {
+        uint8_t index                = last_hit_buffer.count;
+        last_hit_buffer.x[index]     = g_led_config.point[led[i]].x;
+        last_hit_buffer.y[index]     = g_led_config.point[led[i]].y;
+        last_hit_buffer.index[index] = led[i];
+        last_hit_buffer.tick[index]  = tick;
+        last_hit_buffer.count++;
+    }
+}
+#endif // RGB_MATRIX_KEYREACTIVE_ENABLED
+
 void process_rgb_matrix(uint8_t row, uint8_t col, bool pressed) {
 #ifndef RGB_MATRIX_SPLIT
     if (!is_keyboard_master()) return;
@@ -230,22 +300,21 @@ void process_rgb_matrix(uint8_t row, uint8_t col, bool pressed) {
         led_count = rgb_matrix_map_row_column_to_led(row, col, led);
     }
 
-    if (last_hit_buffer.count + led_count > LED_HITS_TO_REMEMBER) {
-        memcpy(&last_hit_buffer.x[0], &last_hit_buffer.x[led_count], LED_HITS_TO_REMEMBER - led_count);
-        memcpy(&last_hit_buffer.y[0], &last_hit_buffer.y[led_count], LED_HITS_TO_REMEMBER - led_count);
-        memcpy(&last_hit_buffer.tick[0], &last_hit_buffer.tick[led_count], (LED_HITS_TO_REMEMBER - led_count) * 2); // 16 bit
-        memcpy(&last_hit_buffer.index[0], &last_hit_buffer.index[led_count], LED_HITS_TO_REMEMBER - led_count);
-        last_hit_buffer.count = LED_HITS_TO_REMEMBER - led_count;
+#    ifdef RGB_MATRIX_SPLIT_LOCKSTEP
+    // The slave takes its hits from the master, so that both halves track the same set
+    if (!is_keyboard_master()) {
+        led_count = 0;
     }
-
     for (uint8_t i = 0; i < led_count; i++) {
-        uint8_t index                = last_hit_buffer.count;
-        last_hit_buffer.x[index]     = g_led_config.point[led[i]].x;
-        last_hit_buffer.y[index]     = g_led_config.point[led[i]].y;
-        last_hit_buffer.index[index] = led[i];
-        last_hit_buffer.tick[index]  = 0;
-        last_hit_buffer.count++;
+        memmove(&rgb_lockstep_hits.hit_index[0], &rgb_lockstep_hits.hit_index[1], RGB_MATRIX_SPLIT_LOCKSTEP_HITS - 1);
+        memmove(&rgb_lockstep_hits.hit_time[0], &rgb_lockstep_hits.hit_time[1], (RGB_MATRIX_SPLIT_LOCKSTEP_HITS - 1) * 2); // 16 bit
+        rgb_lockstep_hits.hit_index[RGB_MATRIX_SPLIT_LOCKSTEP_HITS - 1] = led[i];
+        rgb_lockstep_hits.hit_time[RGB_MATRIX_SPLIT_LOCKSTEP_HITS - 1]  = rgb_clock_read32();
+        rgb_lockstep_hits.hit_sequence++;
     }
+#    endif // RGB_MATRIX_SPLIT_LOCKSTEP
+
+    rgb_matrix_add_hits(led, led_count, 0);
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 
 #if defined(RGB_MATRIX_FRAMEBUFFER_EFFECTS) && defined(ENABLE_RGB_MATRIX_TYPING_HEATMAP)
@@ -288,11 +357,108 @@ static bool rgb_matrix_none(effect_params_t *params) {
     return false;
 }
 
+#ifdef RGB_MATRIX_RENDER_BUDGET_US
+#    ifdef RGB_RENDER_CLOCK_REALTIME
+__attribute__((weak)) uint32_t rgb_matrix_render_clock_us(void) {
+    // Only differences are used, so wrapping is fine. Leftover cycles are carried over,
+    // so that short calls don't all round down to nothing.
+    static rtcnt_t  last   = 0;
+    static uint32_t cycles = 0;
+    static uint32_t us     = 0;
+
+    rtcnt_t now = chSysGetRealtimeCounterX();
+    cycles += now - last;
+    last = now;
+    us += cycles / (CPU_CLOCK / 1000000);
+    cycles %= CPU_CLOCK / 1000000;
+    return us;
+}
+#    else
+__attribute__((weak)) uint32_t rgb_matrix_render_clock_us(void) {
+    // Only differences are used, so wrapping is fine. Few render calls span a tick of the
+    // millisecond timer, but those that do average out to the real cost over many frames.
+    return timer_read32() * 1000;
+}
+#    endif // RGB_RENDER_CLOCK_REALTIME
+
+const rgb_matrix_render_stats_t *rgb_matrix_get_render_stats(void) {
+    rgb_render_stats.chunk = rgb_render_chunk;
+    return &rgb_render_stats;
+}
+
+static void rgb_render_budget_start(void) {
+    // Each half only renders its own LEDs
+#    if defined(RGB_MATRIX_SPLIT)
+    rgb_render_next_led = is_keyboard_left() ? 0 : k_rgb_matrix_split[0];
+    rgb_render_last_led = is_keyboard_left() ? k_rgb_matrix_split[0] : DRIVER_LED_TOTAL;
+#    else
+    rgb_render_next_led = 0;
+#    endif
+    rgb_render_frame_us   = 0;
+    rgb_render_frame_leds = 0;
+}
+
+static void rgb_render_budget_begin(void) {
+    uint16_t max = rgb_render_next_led + rgb_render_chunk;
+
+    rgb_effect_params.led_min = rgb_render_next_led;
+    rgb_effect_params.led_max = max < rgb_render_last_led ? max : rgb_render_last_led;
+    rgb_render_call_start     = rgb_matrix_render_clock_us();
+}
+
+static void rgb_render_budget_frame(uint8_t effect) {
+    // Average cost of one LED over whole frames, starting afresh for a new effect
+    if (rgb_render_frame_leds) {
+        uint32_t sample = rgb_render_frame_us * 1000 / rgb_render_frame_leds;
+        if (effect != rgb_render_effect) {
+            rgb_render_effect            = effect;
+            rgb_render_stats.led_cost_ns = sample;
+        } else {
+            rgb_render_stats.led_cost_ns = rgb_render_stats.led_cost_ns - rgb_render_stats.led_cost_ns / 8 + sample / 8;
+        }
+
+        uint32_t chunk   = rgb_render_stats.led_cost_ns ? (uint32_t)RGB_MATRIX_RENDER_BUDGET_US * 1000 / rgb_render_stats.led_cost_ns : DRIVER_LED_TOTAL;
+        rgb_render_chunk = chunk < 1 ? 1 : (chunk > DRIVER_LED_TOTAL ? DRIVER_LED_TOTAL : chunk);
+    }
+
+    rgb_render_fps_frames++;
+    uint32_t elapsed = timer_elapsed32(rgb_render_fps_timer);
+    if (elapsed >= 1000) {
+        rgb_render_stats.fps  = (uint32_t)rgb_render_fps_frames * 1000 / elapsed;
+        rgb_render_fps_frames = 0;
+        rgb_render_fps_timer  = timer_read32();
+    }
+}
+
+static void rgb_render_budget_end(uint8_t effect) {
+    uint32_t elapsed = rgb_matrix_render_clock_us() - rgb_render_call_start;
+#    ifdef RGB_MATRIX_RENDER_CLOCK_PRECISE
+    // A single call can't be timed against the millisecond timer
+    if (elapsed > RGB_MATRIX_RENDER_BUDGET_US) {
+        rgb_render_stats.overruns++;
+    }
+#    endif
+
+    rgb_render_frame_us += elapsed;
+    rgb_render_frame_leds += rgb_effect_params.led_max - rgb_effect_params.led_min;
+    rgb_render_next_led = rgb_effect_params.led_max;
+
+    // The frame is done once the effect stops rendering
+    if (rgb_task_state != RENDERING) {
+        rgb_render_budget_frame(effect);
+    }
+}
+#else
+#    define rgb_render_budget_start()
+#    define rgb_render_budget_begin()
+#    define rgb_render_budget_end(effect)
+#endif // RGB_MATRIX_RENDER_BUDGET_US
+
 static void rgb_task_timers(void) {
 #if defined(RGB_MATRIX_KEYREACTIVE_ENABLED) || RGB_DISABLE_TIMEOUT > 0
-    uint32_t deltaTime = sync_timer_elapsed32(rgb_timer_buffer);
+    uint32_t deltaTime = rgb_clock_read32() - rgb_timer_buffer;
 #endif // defined(RGB_MATRIX_KEYREACTIVE_ENABLED) || RGB_DISABLE_TIMEOUT > 0
-    rgb_timer_buffer = sync_timer_read32();
+    rgb_timer_buffer = rgb_clock_read32();
 
     // Update double buffer timers
 #if RGB_DISABLE_TIMEOUT > 0
@@ -317,15 +483,21 @@ static void rgb_task_timers(void) {
 static void rgb_task_sync(void) {
     eeconfig_flush_rgb_matrix(false);
     // next task
-    if (sync_timer_elapsed32(g_rgb_timer) >= RGB_MATRIX_LED_FLUSH_LIMIT) rgb_task_state = STARTING;
+    if (rgb_clock_read32() - g_rgb_timer >= RGB_MATRIX_LED_FLUSH_LIMIT) rgb_task_state = STARTING;
 }
 
 static void rgb_task_start(void) {
     // reset iter
     rgb_effect_params.iter = 0;
+    rgb_render_budget_start();
 
     // update double buffers
+#ifdef RGB_MATRIX_SPLIT_LOCKSTEP
+    // Align frames to the shared clock, so that both halves render the same frame timestamps
+    g_rgb_timer = rgb_timer_buffer - rgb_timer_buffer % RGB_MATRIX_LED_FLUSH_LIMIT;
+#else
     g_rgb_timer = rgb_timer_buffer;
+#endif // RGB_MATRIX_SPLIT_LOCKSTEP
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
     g_last_hit_tracker = last_hit_buffer;
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
@@ -424,11 +596,13 @@ void rgb_matrix_task(void) {
             rgb_task_start();
             break;
         case RENDERING:
+            rgb_render_budget_begin();
             rgb_task_render(effect);
             if (effect) {
                 rgb_matrix_indicators();
                 rgb_matrix_indicators_advanced(&rgb_effect_params);
             }
+            rgb_render_budget_end(effect);
             break;
         case FLUSHING:
             rgb_task_flush(effect);
@@ -454,7 +628,10 @@ void rgb_matrix_indicators_advanced(effect_params_t *params) {
      * and not sure which would be better. Otherwise, this should be called from
      * rgb_task_render, right before the iter++ line.
      */
-#if defined(RGB_MATRIX_LED_PROCESS_LIMIT) && RGB_MATRIX_LED_PROCESS_LIMIT > 0 && RGB_MATRIX_LED_PROCESS_LIMIT < DRIVER_LED_TOTAL
+#if defined(RGB_MATRIX_RENDER_BUDGET_US)
+    uint8_t min = params->led_min;
+    uint8_t max = params->led_max;
+#elif defined(RGB_MATRIX_LED_PROCESS_LIMIT) && RGB_MATRIX_LED_PROCESS_LIMIT > 0 && RGB_MATRIX_LED_PROCESS_LIMIT < DRIVER_LED_TOTAL
     uint8_t min = RGB_MATRIX_LED_PROCESS_LIMIT * (params->iter - 1);
     uint8_t max = min + RGB_MATRIX_LED_PROCESS_LIMIT;
     if (max > DRIVER_LED_TOTAL) max = DRIVER_LED_TOTAL;
@@ -470,8 +647,25 @@ __attribute__((weak)) void rgb_matrix_indicators_advanced_kb(uint8_t led_min, ui
 
 __attribute__((weak)) void rgb_matrix_indicators_advanced_user(uint8_t led_min, uint8_t led_max) {}
 
+#ifdef RGB_MATRIX_GEOMETRY_CACHE
+static void rgb_matrix_init_geometry(void) {
+    for (uint8_t i = 0; i < DRIVER_LED_TOTAL; i++) {
+        int16_t dx = g_led_config.point[i].x - k_rgb_matrix_center.x;
+        int16_t dy = g_led_config.point[i].y - k_rgb_matrix_center.y;
+
+        g_led_geometry[i].dx    = dx;
+        g_led_geometry[i].dy    = dy;
+        g_led_geometry[i].dist  = sqrt16(dx * dx + dy * dy);
+        g_led_geometry[i].angle = atan2_8(dy, dx);
+    }
+}
+#endif // RGB_MATRIX_GEOMETRY_CACHE
+
 void rgb_matrix_init(void) {
     rgb_matrix_driver.init();
+#ifdef RGB_MATRIX_GEOMETRY_CACHE
+    rgb_matrix_init_geometry();
+#endif // RGB_MATRIX_GEOMETRY_CACHE
 
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
     g_last_hit_tracker.count = 0;
@@ -485,6 +679,10 @@ void rgb_matrix_init(void) {
     }
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 
+#ifdef RGB_MATRIX_REACTIVE_SPLASH_ENABLED
+    reactive_splash_grid_init();
+#endif // RGB_MATRIX_REACTIVE_SPLASH_ENABLED
+
     if (!eeconfig_is_enabled()) {
         dprintf("rgb_matrix_init_drivers eeconfig is not enabled.\n");
         eeconfig_init();
@@ -499,6 +697,41 @@ void rgb_matrix_init(void) {
     eeconfig_debug_rgb_matrix(); // display current eeprom values
 }
 
+#ifdef RGB_MATRIX_SPLIT_LOCKSTEP
+void rgb_matrix_lockstep_get(rgb_matrix_lockstep_t *lockstep) {
+#    ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
+    memcpy(lockstep, &rgb_lockstep_hits, sizeof(rgb_matrix_lockstep_t));
+#    endif // RGB_MATRIX_KEYREACTIVE_ENABLED
+    lockstep->timer = rgb_clock_read32();
+}
+
+void rgb_matrix_lockstep_apply(const rgb_matrix_lockstep_t *lockstep) {
+    // Slew towards the master's clock a millisecond at a time, so that animations never jump, unless far out
+    int32_t error = lockstep->timer - rgb_clock_read32();
+    if (error > RGB_MATRIX_SPLIT_LOCKSTEP_SNAP_MS || error < -RGB_MATRIX_SPLIT_LOCKSTEP_SNAP_MS) {
+        rgb_lockstep_offset += error;
+        rgb_timer_buffer = rgb_clock_read32();
+    } else {
+        int8_t step = error > 0 ? 1 : (error < 0 ? -1 : 0);
+        // Moving the timer buffer along keeps the slew out of the hit and timeout timers
+        rgb_lockstep_offset += step;
+        rgb_timer_buffer += step;
+    }
+
+#    ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
+    uint8_t new_hits = lockstep->hit_sequence - rgb_lockstep_hits.hit_sequence;
+    if (new_hits > RGB_MATRIX_SPLIT_LOCKSTEP_HITS) {
+        new_hits = RGB_MATRIX_SPLIT_LOCKSTEP_HITS;
+    }
+    // Replay with the age each hit had on the master, the regular timer update takes it from there
+    for (uint8_t i = RGB_MATRIX_SPLIT_LOCKSTEP_HITS - new_hits; i < RGB_MATRIX_SPLIT_LOCKSTEP_HITS; i++) {
+        rgb_matrix_add_hits(&lockstep->hit_index[i], 1, (uint16_t)lockstep->timer - lockstep->hit_time[i]);
+    }
+    memcpy(&rgb_lockstep_hits, lockstep, sizeof(rgb_matrix_lockstep_t));
+#    endif // RGB_MATRIX_KEYREACTIVE_ENABLED
+}
+#endif // RGB_MATRIX_SPLIT_LOCKSTEP
+
 void rgb_matrix_set_suspend_state(bool state) {
 #ifdef RGB_DISABLE_WHEN_USB_SUSPENDED
     if (state && !suspend_state) { // only run if turning off, and only once
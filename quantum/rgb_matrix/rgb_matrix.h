@@ -50,7 +50,29 @@
 #    define RGB_MATRIX_LED_PROCESS_LIMIT (DRIVER_LED_TOTAL + 4) / 5
 #endif
 
-#if defined(RGB_MATRIX_LED_PROCESS_LIMIT) && RGB_MATRIX_LED_PROCESS_LIMIT > 0 && RGB_MATRIX_LED_PROCESS_LIMIT < DRIVER_LED_TOTAL
+#ifdef RGB_MATRIX_SPLIT_LOCKSTEP
+#    ifndef RGB_MATRIX_SPLIT_LOCKSTEP_INTERVAL
+#        define RGB_MATRIX_SPLIT_LOCKSTEP_INTERVAL 20
+#    endif
+#    ifndef RGB_MATRIX_SPLIT_LOCKSTEP_SNAP_MS
+#        define RGB_MATRIX_SPLIT_LOCKSTEP_SNAP_MS 100
+#    endif
+#endif
+
+#if defined(RGB_MATRIX_RENDER_BUDGET_US)
+#    if defined(RGB_MATRIX_SPLIT)
+#        define RGB_MATRIX_USE_LIMITS(min, max)                                                   \
+            uint8_t min                   = params->led_min;                                      \
+            uint8_t max                   = params->led_max;                                      \
+            uint8_t k_rgb_matrix_split[2] = RGB_MATRIX_SPLIT;                                     \
+            if (is_keyboard_left() && (max > k_rgb_matrix_split[0])) max = k_rgb_matrix_split[0]; \
+            if (!(is_keyboard_left()) && (min < k_rgb_matrix_split[0])) min = k_rgb_matrix_split[0];
+#    else
+#        define RGB_MATRIX_USE_LIMITS(min, max) \
+            uint8_t min = params->led_min;      \
+            uint8_t max = params->led_max;
+#    endif
+#elif defined(RGB_MATRIX_LED_PROCESS_LIMIT) && RGB_MATRIX_LED_PROCESS_LIMIT > 0 && RGB_MATRIX_LED_PROCESS_LIMIT < DRIVER_LED_TOTAL
 #    if defined(RGB_MATRIX_SPLIT)
 #        define RGB_MATRIX_USE_LIMITS(min, max)                                                   \
             uint8_t min = RGB_MATRIX_LED_PROCESS_LIMIT * params->iter;                            \
@@ -140,6 +162,19 @@ void rgb_matrix_init(void);
 
 void rgb_matrix_reload_from_eeprom(void);
 
+#ifdef RGB_MATRIX_SPLIT_LOCKSTEP
+// Master: captures the frame clock and recent hits to send to the slave
+void rgb_matrix_lockstep_get(rgb_matrix_lockstep_t *lockstep);
+// Slave: slews the frame clock towards the master's, and replays any new hits
+void rgb_matrix_lockstep_apply(const rgb_matrix_lockstep_t *lockstep);
+#endif
+
+#ifdef RGB_MATRIX_RENDER_BUDGET_US
+// Free running microsecond clock used to time the rendering, the default has millisecond resolution
+uint32_t                         rgb_matrix_render_clock_us(void);
+const rgb_matrix_render_stats_t *rgb_matrix_get_render_stats(void);
+#endif
+
 void        rgb_matrix_set_suspend_state(bool state);
 bool        rgb_matrix_get_suspend_state(void);
 void        rgb_matrix_toggle(void);
@@ -263,3 +298,6 @@ extern last_hit_t g_last_hit_tracker;
 #ifdef RGB_MATRIX_FRAMEBUFFER_EFFECTS
 extern uint8_t g_rgb_frame_buffer[MATRIX_ROWS][MATRIX_COLS];
 #endif
+#ifdef RGB_MATRIX_GEOMETRY_CACHE
+extern led_geometry_t g_led_geometry[DRIVER_LED_TOTAL];
+#endif
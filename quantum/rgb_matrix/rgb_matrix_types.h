@@ -34,6 +34,11 @@
 #    define RGB_MATRIX_KEYREACTIVE_ENABLED
 #endif
 
+// Effects drawn by effect_runner_reactive_splash_culled, which needs the LED grid
+#if defined(RGB_MATRIX_KEYREACTIVE_ENABLED) && (defined(ENABLE_RGB_MATRIX_SPLASH) || defined(ENABLE_RGB_MATRIX_MULTISPLASH) || defined(ENABLE_RGB_MATRIX_SOLID_SPLASH) || defined(ENABLE_RGB_MATRIX_SOLID_MULTISPLASH) || defined(ENABLE_RGB_MATRIX_SOLID_REACTIVE_NEXUS) || defined(ENABLE_RGB_MATRIX_SOLID_REACTIVE_MULTINEXUS) || defined(ENABLE_RGB_MATRIX_SOLID_REACTIVE_WIDE) || defined(ENABLE_RGB_MATRIX_SOLID_REACTIVE_MULTIWIDE) || defined(ENABLE_RGB_MATRIX_SOLID_REACTIVE_CROSS) || defined(ENABLE_RGB_MATRIX_SOLID_REACTIVE_MULTICROSS))
+#    define RGB_MATRIX_REACTIVE_SPLASH_ENABLED
+#endif
+
 // Last led hit
 #ifndef LED_HITS_TO_REMEMBER
 #    define LED_HITS_TO_REMEMBER 8
@@ -49,6 +54,22 @@ typedef struct PACKED {
 } last_hit_t;
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 
+#ifdef RGB_MATRIX_SPLIT_LOCKSTEP
+#    ifndef RGB_MATRIX_SPLIT_LOCKSTEP_HITS
+#        define RGB_MATRIX_SPLIT_LOCKSTEP_HITS 4
+#    endif // RGB_MATRIX_SPLIT_LOCKSTEP_HITS
+
+// Frame clock and most recent key hits, as sent from the master half
+typedef struct PACKED {
+    uint32_t timer;
+#    ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
+    uint8_t  hit_sequence; // number of hits recorded, wrapping
+    uint8_t  hit_index[RGB_MATRIX_SPLIT_LOCKSTEP_HITS];
+    uint16_t hit_time[RGB_MATRIX_SPLIT_LOCKSTEP_HITS]; // frame clock when the key was hit, newest last
+#    endif // RGB_MATRIX_KEYREACTIVE_ENABLED
+} rgb_matrix_lockstep_t;
+#endif // RGB_MATRIX_SPLIT_LOCKSTEP
+
 typedef enum rgb_task_states { STARTING, RENDERING, FLUSHING, SYNCING } rgb_task_states;
 
 typedef uint8_t led_flags_t;
@@ -57,8 +78,21 @@ typedef struct PACKED {
     uint8_t     iter;
     led_flags_t flags;
     bool        init;
+#ifdef RGB_MATRIX_RENDER_BUDGET_US
+    uint8_t led_min; // LEDs to render in this iteration, sized to the budget
+    uint8_t led_max;
+#endif // RGB_MATRIX_RENDER_BUDGET_US
 } effect_params_t;
 
+#ifdef RGB_MATRIX_RENDER_BUDGET_US
+typedef struct {
+    uint16_t fps;         // frames rendered over the last second
+    uint8_t  chunk;       // LEDs rendered per call to rgb_matrix_task()
+    uint32_t led_cost_ns; // measured cost of rendering one LED of the current effect
+    uint32_t overruns;    // render calls that took longer than RGB_MATRIX_RENDER_BUDGET_US
+} rgb_matrix_render_stats_t;
+#endif // RGB_MATRIX_RENDER_BUDGET_US
+
 typedef struct PACKED {
     uint8_t x;
     uint8_t y;
@@ -76,6 +110,16 @@ typedef struct PACKED {
 
 #define NO_LED 255
 
+#ifdef RGB_MATRIX_GEOMETRY_CACHE
+// Position of an LED relative to k_rgb_matrix_center
+typedef struct PACKED {
+    int16_t dx;
+    int16_t dy;
+    uint8_t dist;  // sqrt16(dx * dx + dy * dy)
+    uint8_t angle; // atan2_8(dy, dx)
+} led_geometry_t;
+#endif // RGB_MATRIX_GEOMETRY_CACHE
+
 typedef struct PACKED {
     uint8_t     matrix_co[MATRIX_ROWS][MATRIX_COLS];
     led_point_t point[DRIVER_LED_TOTAL];
@@ -31,6 +31,10 @@
 #    include "rgblight.h"
 #endif
 
+#ifdef SPLIT_RPC_QUEUE_ENABLE
+#    include "transactions.h"
+#endif
+
 #ifndef SPLIT_USB_TIMEOUT
 #    define SPLIT_USB_TIMEOUT 2000
 #endif
@@ -148,6 +152,9 @@ void split_pre_init(void) {
         matrix_master_OLED_init();
 #endif
         transport_master_init();
+#ifdef SPLIT_SLAVE_EVENT_PIN
+        setPinInputHigh(SPLIT_SLAVE_EVENT_PIN);
+#endif
     }
 }
 
@@ -156,6 +163,11 @@ void split_pre_init(void) {
 //     receiving before the init process has completed
 void split_post_init(void) {
     if (!is_keyboard_master()) {
+#ifdef SPLIT_SLAVE_EVENT_PIN
+        // Active low, driven while the slave has input waiting for the master
+        writePinHigh(SPLIT_SLAVE_EVENT_PIN);
+        setPinOutput(SPLIT_SLAVE_EVENT_PIN);
+#endif
         transport_slave_init();
     }
 }
@@ -175,6 +187,13 @@ bool transport_master_if_connected(matrix_row_t master_matrix[], matrix_row_t sl
     }
 #endif // SPLIT_MAX_CONNECTION_ERRORS > 0 && SPLIT_CONNECTION_CHECK_TIMEOUT > 0
 
+#ifdef SPLIT_RPC_QUEUE_ENABLE
+    if (!is_transport_connected()) {
+        // The slave may have missed frames, or been swapped, while the link was down
+        transaction_rpc_queue_restart();
+    }
+#endif // SPLIT_RPC_QUEUE_ENABLE
+
     __attribute__((unused)) bool okay = transport_master(master_matrix, slave_matrix);
 #if SPLIT_MAX_CONNECTION_ERRORS > 0
     if (!okay) {
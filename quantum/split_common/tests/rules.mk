@@ -0,0 +1,39 @@
+SPLIT_TRANSACTIONS_COMMON_DEFS := -DNO_DEBUG -DSPLIT_KEYBOARD -DSPLIT_TRANSPORT_MIRROR -DMATRIX_ROWS=4 -DMATRIX_COLS=10
+
+SPLIT_TRANSACTIONS_COMMON_INC := $(QUANTUM_PATH)/split_common
+
+SPLIT_TRANSACTIONS_COMMON_SRC := \
+	$(QUANTUM_PATH)/split_common/tests/split_transactions_tests.cpp \
+	$(QUANTUM_PATH)/split_common/transactions.c \
+	$(QUANTUM_PATH)/sync_timer.c \
+	$(QUANTUM_PATH)/crc.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/split_loopback.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c
+
+split_transactions_DEFS := $(SPLIT_TRANSACTIONS_COMMON_DEFS)
+split_transactions_INC := $(SPLIT_TRANSACTIONS_COMMON_INC)
+split_transactions_SRC := $(SPLIT_TRANSACTIONS_COMMON_SRC)
+
+split_transactions_batch_DEFS := $(SPLIT_TRANSACTIONS_COMMON_DEFS) -DSPLIT_TRANSACTION_BATCH
+split_transactions_batch_INC := $(SPLIT_TRANSACTIONS_COMMON_INC)
+split_transactions_batch_SRC := $(SPLIT_TRANSACTIONS_COMMON_SRC)
+
+split_transactions_events_DEFS := $(SPLIT_TRANSACTIONS_COMMON_DEFS) -DSPLIT_SLAVE_EVENTS_ENABLE
+split_transactions_events_INC := $(SPLIT_TRANSACTIONS_COMMON_INC)
+split_transactions_events_SRC := $(SPLIT_TRANSACTIONS_COMMON_SRC)
+
+split_transactions_rpc_DEFS := $(SPLIT_TRANSACTIONS_COMMON_DEFS) -DSPLIT_RPC_QUEUE_ENABLE -DSPLIT_TRANSACTION_IDS_USER=USER_RPC_ECHO
+split_transactions_rpc_INC := $(SPLIT_TRANSACTIONS_COMMON_INC)
+split_transactions_rpc_SRC := $(SPLIT_TRANSACTIONS_COMMON_SRC)
+
+split_transactions_pointing_DEFS := $(SPLIT_TRANSACTIONS_COMMON_DEFS) -DPOINTING_DEVICE_ENABLE -DSPLIT_POINTING_ENABLE -DPOINTING_DEVICE_RIGHT
+split_transactions_pointing_INC := $(SPLIT_TRANSACTIONS_COMMON_INC)
+split_transactions_pointing_SRC := $(SPLIT_TRANSACTIONS_COMMON_SRC)
+
+split_transactions_oled_DEFS := $(SPLIT_TRANSACTIONS_COMMON_DEFS) -DOLED_ENABLE -DSPLIT_OLED_ENABLE -DSPLIT_OLED_MIRROR_ENABLE
+split_transactions_oled_INC := $(SPLIT_TRANSACTIONS_COMMON_INC) $(DRIVER_PATH)/oled
+split_transactions_oled_SRC := $(SPLIT_TRANSACTIONS_COMMON_SRC)
+
+split_transactions_scheduler_DEFS := $(SPLIT_TRANSACTIONS_COMMON_DEFS) -DSPLIT_SYNC_SCHEDULER_ENABLE -DSPLIT_SYNC_MEASURE_WINDOW_MS=10 -DOLED_ENABLE -DSPLIT_OLED_ENABLE -DSPLIT_OLED_MIRROR_ENABLE
+split_transactions_scheduler_INC := $(SPLIT_TRANSACTIONS_COMMON_INC) $(DRIVER_PATH)/oled
+split_transactions_scheduler_SRC := $(SPLIT_TRANSACTIONS_COMMON_SRC)
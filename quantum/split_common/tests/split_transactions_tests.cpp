@@ -0,0 +1,707 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include <string.h>
+
+extern "C" {
+#include "split_loopback.h"
+#include "timer.h"
+#if defined(SPLIT_RPC_QUEUE_ENABLE) || defined(SPLIT_SYNC_SCHEDULER_ENABLE) || defined(SPLIT_OLED_MIRROR_ENABLE)
+// The transaction IDs are checked with a C11 assertion
+#    define _Static_assert static_assert
+#    include "transactions.h"
+#endif // defined(SPLIT_RPC_QUEUE_ENABLE) || defined(SPLIT_SYNC_SCHEDULER_ENABLE) || defined(SPLIT_OLED_MIRROR_ENABLE)
+
+void advance_time(uint32_t ms);
+
+bool is_keyboard_master(void) {
+    return !split_loopback_is_slave();
+}
+
+bool is_transport_connected(void) {
+    return true;
+}
+
+#if defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+#    include "pointing_device.h"
+
+// The master is the left half, the pointing device is on the slave
+bool is_keyboard_left(void) {
+    return !split_loopback_is_slave();
+}
+
+static report_mouse_t sensor_report;
+static int32_t        master_motion_x;
+static int32_t        master_motion_y;
+static uint8_t        master_buttons;
+
+static report_mouse_t sensor_get_report(report_mouse_t mouse_report) {
+    return sensor_report;
+}
+
+extern const pointing_device_driver_t pointing_device_driver = {.get_report = sensor_get_report};
+
+void pointing_device_add_shared_motion(uint8_t buttons, int16_t x, int16_t y, int16_t v, int16_t h) {
+    master_buttons = buttons;
+    master_motion_x += x;
+    master_motion_y += y;
+}
+
+uint16_t pointing_device_get_shared_cpi(void) {
+    return 0;
+}
+#endif // defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+
+#ifdef SPLIT_OLED_MIRROR_ENABLE
+#    include "oled_driver.h"
+
+// A display buffer for each half, indexed by split_loopback_is_slave()
+static uint8_t         display_buffer[2][OLED_MATRIX_SIZE];
+static OLED_BLOCK_TYPE display_changed[2];
+static bool            display_on[2];
+
+oled_buffer_reader_t oled_read_raw(uint16_t start_index) {
+    oled_buffer_reader_t reader = {&display_buffer[split_loopback_is_slave()][start_index], (uint16_t)(OLED_MATRIX_SIZE - start_index)};
+    return reader;
+}
+
+void oled_write_raw_byte(const char data, uint16_t index) {
+    display_buffer[split_loopback_is_slave()][index] = data;
+    display_changed[split_loopback_is_slave()] |= (OLED_BLOCK_TYPE)1 << (index / OLED_BLOCK_SIZE);
+}
+
+OLED_BLOCK_TYPE oled_take_changed_blocks(void) {
+    OLED_BLOCK_TYPE changed                    = display_changed[split_loopback_is_slave()];
+    display_changed[split_loopback_is_slave()] = 0;
+    return changed;
+}
+
+bool oled_on(void) {
+    return display_on[split_loopback_is_slave()] = true;
+}
+
+bool oled_off(void) {
+    return display_on[split_loopback_is_slave()] = false;
+}
+
+bool is_oled_on(void) {
+    return display_on[split_loopback_is_slave()];
+}
+#endif // SPLIT_OLED_MIRROR_ENABLE
+}
+
+#define ROWS_PER_HAND ((MATRIX_ROWS) / 2)
+// Longer than FORCED_SYNC_THROTTLE_MS, so that every half-synced state gets refreshed
+#define RESYNC_MS 200
+
+class SplitTransactions : public ::testing::Test {
+   protected:
+    matrix_row_t master_local[ROWS_PER_HAND];
+    matrix_row_t master_remote[ROWS_PER_HAND];
+    matrix_row_t slave_local[ROWS_PER_HAND];
+    matrix_row_t slave_remote[ROWS_PER_HAND];
+
+    void SetUp() override {
+        split_loopback_reset();
+        memset(master_local, 0, sizeof(master_local));
+        memset(slave_local, 0, sizeof(slave_local));
+        // Settle both halves on an empty matrix, so earlier tests don't leak into this one
+        settle();
+        split_loopback_reset();
+    }
+
+    // One scan on each half, slave first as it would usually have its matrix ready
+    bool cycle() {
+        split_loopback_slave(slave_remote, slave_local);
+        bool okay = split_loopback_master(master_local, master_remote);
+        advance_time(1);
+        return okay;
+    }
+
+    void settle() {
+        cycle();
+        advance_time(RESYNC_MS);
+        cycle();
+        cycle();
+    }
+};
+
+TEST_F(SplitTransactions, SlaveMatrixReachesMaster) {
+    slave_local[1] = 0x0204;
+    EXPECT_TRUE(cycle());
+    EXPECT_EQ(master_remote[0], 0);
+    EXPECT_EQ(master_remote[1], 0x0204);
+}
+
+TEST_F(SplitTransactions, MasterMatrixIsMirroredToSlave) {
+    master_local[0] = 0x0081;
+    EXPECT_TRUE(cycle());
+    // The slave applies the received data on its next scan
+    split_loopback_slave(slave_remote, slave_local);
+    EXPECT_EQ(slave_remote[0], 0x0081);
+    EXPECT_EQ(slave_remote[1], 0);
+}
+
+TEST_F(SplitTransactions, IdleCycleIsOneExchange) {
+    const split_loopback_stats_t *stats = split_loopback_get_stats();
+#if defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+    // The reset restarted the slave, which is given the pointing epoch again on the first cycle
+    EXPECT_TRUE(cycle());
+#endif
+    split_loopback_stats_t before = *stats;
+    EXPECT_TRUE(cycle());
+    EXPECT_EQ(stats->cycles - before.cycles, 1);
+    EXPECT_EQ(stats->failures, 0);
+    // Only the slave matrix checksum, edge count or batched frame is needed when nothing changed
+#if defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+    // plus the pointing totals, which are read every cycle
+    EXPECT_EQ(stats->transactions - before.transactions, 2);
+#else
+    EXPECT_EQ(stats->transactions - before.transactions, 1);
+#endif
+}
+
+TEST_F(SplitTransactions, DroppedBytesFailTheCycle) {
+    split_loopback_faults_t faults = {};
+    faults.drop_byte_ppm           = 1000000;
+    split_loopback_set_faults(&faults);
+
+    slave_local[0] = 0x0001;
+    EXPECT_FALSE(cycle());
+    const split_loopback_stats_t *stats = split_loopback_get_stats();
+    EXPECT_GT(stats->transactions, 1);
+    EXPECT_EQ(stats->failures, stats->transactions);
+
+    // Recovers once the link does
+    faults.drop_byte_ppm = 0;
+    split_loopback_set_faults(&faults);
+    EXPECT_TRUE(cycle());
+    EXPECT_EQ(master_remote[0], 0x0001);
+}
+
+TEST_F(SplitTransactions, BitErrorsNeverReachTheMatrix) {
+    // Roughly one corrupted frame in twenty, each caught by the crc8 checks
+    split_loopback_faults_t faults = {};
+    faults.bit_error_ppm           = 250;
+    split_loopback_set_faults(&faults);
+
+    const matrix_row_t patterns[] = {0x0001, 0x0300, 0x0000, 0x03FF, 0x0155};
+    for (int i = 0; i < 500; ++i) {
+        slave_local[0] = patterns[i % 5];
+        slave_local[1] = patterns[(i + 2) % 5];
+        cycle();
+        // Whatever got through must be a state the slave has actually been in
+        bool known = false;
+        for (int j = 0; j < 5; ++j) {
+            known |= master_remote[0] == patterns[j];
+        }
+        EXPECT_TRUE(known) << "corrupted row " << master_remote[0] << " on cycle " << i;
+    }
+    EXPECT_GT(split_loopback_get_stats()->bit_errors, 0);
+    EXPECT_GT(split_loopback_get_stats()->failures, 0);
+}
+
+TEST_F(SplitTransactions, RecoversFromNoisyLink) {
+    // Heavy enough noise for the odd crc8 collision to let bad data through
+    split_loopback_faults_t faults = {};
+    faults.bit_error_ppm           = 20000;
+    split_loopback_set_faults(&faults);
+
+    for (int i = 0; i < 200; ++i) {
+        slave_local[0]  = i & 0x03FF;
+        slave_local[1]  = ~i & 0x03FF;
+        master_local[0] = i & 0x00FF;
+        cycle();
+    }
+
+    faults.bit_error_ppm = 0;
+    split_loopback_set_faults(&faults);
+    settle();
+    EXPECT_EQ(master_remote[0], slave_local[0]);
+    EXPECT_EQ(master_remote[1], slave_local[1]);
+}
+
+TEST_F(SplitTransactions, SyncLatencyIsReported) {
+    split_loopback_faults_t faults = {};
+    faults.byte_time_us            = 10;
+    faults.delay_us                = 50;
+    split_loopback_set_faults(&faults);
+
+    slave_local[0] = 0x0010;
+    EXPECT_TRUE(cycle());
+    EXPECT_TRUE(cycle());
+    const split_loopback_stats_t *stats = split_loopback_get_stats();
+    EXPECT_EQ(stats->wire_time_us, stats->bytes * 10 + stats->transactions * 50);
+    EXPECT_EQ(split_loopback_sync_latency_us(), stats->wire_time_us / 2);
+}
+
+#ifdef SPLIT_SLAVE_EVENTS_ENABLE
+TEST_F(SplitTransactions, TapBetweenReadsIsKept) {
+    slave_local[0] = 0x0004;
+    split_loopback_slave(slave_remote, slave_local);
+    slave_local[0] = 0x0000;
+    split_loopback_slave(slave_remote, slave_local);
+
+    EXPECT_TRUE(split_loopback_master(master_local, master_remote));
+    EXPECT_EQ(master_remote[0], 0x0004);
+    EXPECT_TRUE(split_loopback_master(master_local, master_remote));
+    EXPECT_EQ(master_remote[0], 0x0000);
+}
+
+TEST_F(SplitTransactions, OverflowFallsBackToSnapshot) {
+    // More edges than the slave can queue with the default SPLIT_SLAVE_EVENT_BUFFER_SIZE
+    for (int i = 0; i < 10; ++i) {
+        slave_local[1] ^= (1 << (i % 10));
+        split_loopback_slave(slave_remote, slave_local);
+    }
+    EXPECT_TRUE(split_loopback_master(master_local, master_remote));
+    EXPECT_EQ(master_remote[1], slave_local[1]);
+}
+#endif // SPLIT_SLAVE_EVENTS_ENABLE
+
+#ifdef SPLIT_RPC_QUEUE_ENABLE
+static uint8_t slave_executions;
+
+static void slave_echo(uint8_t m2s_size, const void *m2s, uint8_t s2m_size, void *s2m) {
+    // Answers with each request byte incremented
+    slave_executions++;
+    for (uint8_t i = 0; i < s2m_size && i < m2s_size; ++i) {
+        ((uint8_t *)s2m)[i] = ((const uint8_t *)m2s)[i] + 1;
+    }
+}
+
+struct rpc_result_t {
+    int     calls;
+    bool    success;
+    uint8_t size;
+    uint8_t data[RPC_S2M_BUFFER_SIZE];
+};
+static rpc_result_t rpc_results[SPLIT_RPC_QUEUE_LENGTH];
+
+#    define RPC_RESULT_CALLBACK(n)                                                                            \
+        static void rpc_result_##n(int8_t transaction_id, bool success, uint8_t size, const void *data) { \
+            rpc_results[n].calls++;                                                                           \
+            rpc_results[n].success = success;                                                                 \
+            rpc_results[n].size    = size;                                                                    \
+            memcpy(rpc_results[n].data, data, size);                                                          \
+        }
+RPC_RESULT_CALLBACK(0)
+RPC_RESULT_CALLBACK(1)
+RPC_RESULT_CALLBACK(2)
+
+class SplitRpcQueue : public SplitTransactions {
+   protected:
+    void SetUp() override {
+        SplitTransactions::SetUp();
+        transaction_register_rpc(USER_RPC_ECHO, slave_echo);
+        slave_executions = 0;
+        memset(rpc_results, 0, sizeof(rpc_results));
+    }
+};
+
+TEST_F(SplitRpcQueue, QueuedRequestsShareOneExchange) {
+    const uint8_t first[]  = {1, 2, 3};
+    const uint8_t second[] = {10};
+    EXPECT_TRUE(transaction_rpc_queue(USER_RPC_ECHO, sizeof(first), first, sizeof(first), rpc_result_0));
+    EXPECT_TRUE(transaction_rpc_queue_send(USER_RPC_ECHO, sizeof(second), second, rpc_result_1));
+    EXPECT_TRUE(transaction_rpc_queue(USER_RPC_ECHO, sizeof(second), second, sizeof(second), rpc_result_2));
+
+    EXPECT_TRUE(cycle());
+    EXPECT_EQ(slave_executions, 3);
+    // The regular sync, plus one info, data and result transfer for the whole queue
+    EXPECT_EQ(split_loopback_get_stats()->transactions, 1 + 3);
+
+    EXPECT_EQ(rpc_results[0].calls, 1);
+    EXPECT_TRUE(rpc_results[0].success);
+    EXPECT_EQ(rpc_results[0].size, 3);
+    EXPECT_EQ(rpc_results[0].data[0], 2);
+    EXPECT_EQ(rpc_results[0].data[2], 4);
+    EXPECT_EQ(rpc_results[1].calls, 1);
+    EXPECT_TRUE(rpc_results[1].success);
+    EXPECT_EQ(rpc_results[1].size, 0);
+    EXPECT_EQ(rpc_results[2].calls, 1);
+    EXPECT_EQ(rpc_results[2].data[0], 11);
+
+    // Callbacks only fire once
+    EXPECT_TRUE(cycle());
+    EXPECT_EQ(rpc_results[0].calls, 1);
+    EXPECT_EQ(slave_executions, 3);
+}
+
+TEST_F(SplitRpcQueue, FullQueueIsRejected) {
+    uint8_t request[SPLIT_RPC_QUEUE_M2S_SIZE] = {0};
+    EXPECT_FALSE(transaction_rpc_queue_send(USER_RPC_ECHO, sizeof(request), request, NULL));
+    for (int i = 0; i < SPLIT_RPC_QUEUE_LENGTH; ++i) {
+        EXPECT_TRUE(transaction_rpc_queue_send(USER_RPC_ECHO, 1, request, NULL));
+    }
+    EXPECT_FALSE(transaction_rpc_queue_send(USER_RPC_ECHO, 1, request, NULL));
+
+    // Space frees up once the queue has been sent
+    EXPECT_TRUE(cycle());
+    EXPECT_TRUE(transaction_rpc_queue_send(USER_RPC_ECHO, 1, request, NULL));
+}
+
+TEST_F(SplitRpcQueue, CoreTransactionsAreRejected) {
+    const uint8_t request[] = {0};
+    EXPECT_FALSE(transaction_rpc_queue_send(GET_RPC_RESP_DATA, sizeof(request), request, NULL));
+    EXPECT_FALSE(transaction_rpc_queue_send(GET_SLAVE_MATRIX_DATA, sizeof(request), request, NULL));
+}
+
+TEST_F(SplitRpcQueue, QueueWaitsForTheLink) {
+    split_loopback_faults_t faults = {};
+    faults.drop_byte_ppm           = 1000000;
+    split_loopback_set_faults(&faults);
+
+    // Nothing is sent while the regular sync is failing
+    const uint8_t request[] = {5};
+    EXPECT_TRUE(transaction_rpc_queue(USER_RPC_ECHO, sizeof(request), request, sizeof(request), rpc_result_0));
+    EXPECT_FALSE(cycle());
+    EXPECT_EQ(rpc_results[0].calls, 0);
+
+    faults.drop_byte_ppm = 0;
+    split_loopback_set_faults(&faults);
+    EXPECT_TRUE(cycle());
+    EXPECT_EQ(rpc_results[0].calls, 1);
+    EXPECT_TRUE(rpc_results[0].success);
+    EXPECT_EQ(rpc_results[0].data[0], 6);
+    EXPECT_EQ(slave_executions, 1);
+}
+
+TEST_F(SplitRpcQueue, RestartedSequenceIsNotTakenForARepeat) {
+    const uint8_t first[]  = {1};
+    const uint8_t second[] = {20};
+
+    transaction_rpc_queue_restart();
+    EXPECT_TRUE(transaction_rpc_queue(USER_RPC_ECHO, sizeof(first), first, sizeof(first), rpc_result_0));
+    EXPECT_TRUE(cycle());
+    EXPECT_EQ(slave_executions, 1);
+    EXPECT_EQ(rpc_results[0].data[0], 2);
+
+    // The master reboots, and its next frame has the same sequence number as the last one
+    transaction_rpc_queue_restart();
+    EXPECT_TRUE(transaction_rpc_queue(USER_RPC_ECHO, sizeof(second), second, sizeof(second), rpc_result_1));
+    EXPECT_TRUE(cycle());
+    EXPECT_EQ(slave_executions, 2);
+    EXPECT_EQ(rpc_results[1].calls, 1);
+    EXPECT_TRUE(rpc_results[1].success);
+    EXPECT_EQ(rpc_results[1].data[0], 21);
+}
+#endif // SPLIT_RPC_QUEUE_ENABLE
+
+#if defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+class SplitPointing : public SplitTransactions {
+   protected:
+    void SetUp() override {
+        memset(&sensor_report, 0, sizeof(sensor_report));
+        SplitTransactions::SetUp();
+        // Resetting the loopback restarts the slave's totals, like a reboot of that half, let the master catch up
+        cycle();
+        split_loopback_reset();
+        master_motion_x = 0;
+        master_motion_y = 0;
+        master_buttons  = 0;
+    }
+
+    // Sensor polls on the slave while the master is busy elsewhere
+    void slave_scans(int count) {
+        for (int i = 0; i < count; ++i) {
+            split_loopback_slave(slave_remote, slave_local);
+            advance_time(1);
+        }
+    }
+};
+
+TEST_F(SplitPointing, MotionReachesMaster) {
+    sensor_report.x = 5;
+    sensor_report.y = -3;
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_TRUE(cycle());
+    }
+    EXPECT_EQ(master_motion_x, 50);
+    EXPECT_EQ(master_motion_y, -30);
+}
+
+TEST_F(SplitPointing, MotionIsAccumulatedWhileMasterIsBusy) {
+    // Far more than a single report, or the old int8 sync, could carry
+    sensor_report.x = 127;
+    sensor_report.y = -127;
+    slave_scans(200);
+    sensor_report.x = 0;
+    sensor_report.y = 0;
+    EXPECT_TRUE(cycle());
+    EXPECT_EQ(master_motion_x, 127 * 200);
+    EXPECT_EQ(master_motion_y, -127 * 200);
+
+    // Nothing is counted twice when the totals are read again
+    EXPECT_TRUE(cycle());
+    EXPECT_EQ(master_motion_x, 127 * 200);
+}
+
+TEST_F(SplitPointing, TotalsWrapAround) {
+    sensor_report.x = -100;
+    for (int round = 0; round < 5; ++round) {
+        slave_scans(200);
+        EXPECT_TRUE(cycle());
+    }
+    EXPECT_EQ(master_motion_x, -100 * 1005);
+}
+
+TEST_F(SplitPointing, SlaveRestartIsNotMotion) {
+    sensor_report.x = 100;
+    slave_scans(50);
+    sensor_report.x = 0;
+    EXPECT_TRUE(cycle());
+    EXPECT_TRUE(cycle());
+    EXPECT_EQ(master_motion_x, 100 * 50);
+
+    // The slave reboots quicker than the master notices it disconnecting, its totals start over
+    split_loopback_reset();
+    sensor_report.x = 7;
+    EXPECT_TRUE(cycle());
+    EXPECT_EQ(master_motion_x, 100 * 50 + 7);
+    EXPECT_TRUE(cycle());
+    EXPECT_EQ(master_motion_x, 100 * 50 + 14);
+}
+
+TEST_F(SplitPointing, ButtonsReachMaster) {
+    sensor_report.buttons = 0x05;
+    EXPECT_TRUE(cycle());
+    EXPECT_EQ(master_buttons, 0x05);
+    sensor_report.buttons = 0;
+    EXPECT_TRUE(cycle());
+    EXPECT_EQ(master_buttons, 0);
+}
+
+TEST_F(SplitPointing, NoCountsLostOnNoisyLink) {
+    split_loopback_faults_t faults = {};
+    faults.drop_byte_ppm           = 20000;
+    faults.bit_error_ppm           = 2000;
+    split_loopback_set_faults(&faults);
+
+    sensor_report.x = 3;
+    for (int i = 0; i < 500; ++i) {
+        cycle();
+    }
+    sensor_report.x = 0;
+    faults.drop_byte_ppm = 0;
+    faults.bit_error_ppm = 0;
+    split_loopback_set_faults(&faults);
+    EXPECT_TRUE(cycle());
+    EXPECT_GT(split_loopback_get_stats()->failures, 0);
+    EXPECT_EQ(master_motion_x, 3 * 500);
+}
+#endif // defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+
+// The mirror tests below assume every frame goes out, without the scheduler holding any back
+#if defined(SPLIT_OLED_MIRROR_ENABLE) && !defined(SPLIT_SYNC_SCHEDULER_ENABLE)
+class SplitOledMirror : public SplitTransactions {
+   protected:
+    void SetUp() override {
+        SplitTransactions::SetUp();
+        // Blank both displays, and let the master send its blank contents over
+        memset(display_buffer, 0, sizeof(display_buffer));
+        display_changed[0] = ~(OLED_BLOCK_TYPE)0;
+        for (int i = 0; i < 20; ++i) {
+            cycle();
+        }
+        split_loopback_reset();
+    }
+
+    // Master side drawing, as the OLED driver would mark it
+    void draw(uint16_t index, uint8_t data) {
+        display_buffer[0][index] = data;
+        display_changed[0] |= (OLED_BLOCK_TYPE)1 << (index / OLED_BLOCK_SIZE);
+    }
+
+    // The slave applies what it was sent on its next scan
+    bool mirrored() {
+        split_loopback_slave(slave_remote, slave_local);
+        return memcmp(display_buffer[0], display_buffer[1], OLED_MATRIX_SIZE) == 0;
+    }
+};
+
+TEST_F(SplitOledMirror, ChangesReachSlave) {
+    draw(0, 0x7E);
+    draw(5, 0x81);
+    draw(OLED_MATRIX_SIZE - 1, 0x3C);
+    EXPECT_TRUE(cycle());
+    EXPECT_TRUE(mirrored());
+    EXPECT_EQ(display_buffer[1][OLED_MATRIX_SIZE - 1], 0x3C);
+}
+
+TEST_F(SplitOledMirror, UnchangedDisplayIsQuiet) {
+    draw(100, 0x55);
+    EXPECT_TRUE(cycle());
+    // Only the regular sync remains once the slave is up to date
+    EXPECT_TRUE(cycle());
+    EXPECT_EQ(split_loopback_get_stats()->transactions, 3 + 1);
+}
+
+TEST_F(SplitOledMirror, FrameIsSizedToItsContents) {
+    EXPECT_TRUE(cycle());
+    uint32_t quiet = split_loopback_get_stats()->bytes;
+
+    // A single byte compresses to a few bytes of data, and only those go over the wire
+    draw(100, 0x55);
+    EXPECT_TRUE(cycle());
+    EXPECT_TRUE(mirrored());
+    uint32_t frame = split_loopback_get_stats()->bytes - 2 * quiet;
+    EXPECT_LT(frame, sizeof(split_oled_mirror_t));
+    // Block index and three runs, with the header, length and two handshakes
+    EXPECT_EQ(frame, 1 + 3 * 2 + sizeof(split_display_mirror_header_t) + 1 + 2 * 2);
+}
+
+TEST_F(SplitOledMirror, CompressedBlocksShareAFrame) {
+    for (uint16_t index = 0; index < OLED_MATRIX_SIZE; index += OLED_BLOCK_SIZE) {
+        draw(index + 3, 0xFF);
+    }
+    for (int i = 0; i < OLED_BLOCK_COUNT; ++i) {
+        cycle();
+    }
+    EXPECT_TRUE(mirrored());
+
+    // Clearing the screen touches every block, but they all fit in a single frame
+    for (uint16_t index = 0; index < OLED_MATRIX_SIZE; index += OLED_BLOCK_SIZE) {
+        draw(index + 3, 0);
+    }
+    EXPECT_TRUE(cycle());
+    EXPECT_TRUE(mirrored());
+}
+
+TEST_F(SplitOledMirror, BudgetLimitsEachFrame) {
+    // Noise doesn't compress, so each frame carries only as many blocks as the budget allows
+    uint32_t state = 1;
+    for (uint16_t index = 0; index < OLED_MATRIX_SIZE; ++index) {
+        state = state * 1103515245 + 12345;
+        draw(index, state >> 16);
+    }
+    // The default budget of one and a half blocks fits only one of them
+    for (int i = 0; i < OLED_BLOCK_COUNT - 1; ++i) {
+        EXPECT_TRUE(cycle());
+        EXPECT_FALSE(mirrored());
+    }
+    EXPECT_TRUE(cycle());
+    EXPECT_TRUE(mirrored());
+}
+
+TEST_F(SplitOledMirror, RecoversFromCorruptedFrames) {
+    split_loopback_faults_t faults = {};
+    faults.bit_error_ppm           = 20000;
+    split_loopback_set_faults(&faults);
+    for (uint16_t index = 0; index < OLED_MATRIX_SIZE; index += 7) {
+        draw(index, index);
+    }
+    for (int i = 0; i < 10; ++i) {
+        cycle();
+    }
+
+    // The slowly cycling refresh resends every block, whatever got lost
+    faults.bit_error_ppm = 0;
+    split_loopback_set_faults(&faults);
+    for (int i = 0; i < OLED_BLOCK_COUNT + 1; ++i) {
+        advance_time(RESYNC_MS);
+        EXPECT_TRUE(cycle());
+    }
+    EXPECT_TRUE(mirrored());
+}
+#endif // defined(SPLIT_OLED_MIRROR_ENABLE) && !defined(SPLIT_SYNC_SCHEDULER_ENABLE)
+
+#ifdef SPLIT_SYNC_SCHEDULER_ENABLE
+class SplitSyncScheduler : public SplitTransactions {
+   protected:
+    uint32_t noise = 1;
+
+    void SetUp() override {
+        SplitTransactions::SetUp();
+        memset(display_buffer, 0, sizeof(display_buffer));
+        display_changed[0] = 0;
+    }
+
+    // Models a link that takes byte_time_us for each byte, and lets the scheduler measure it
+    void link(uint16_t byte_time_us) {
+        split_loopback_faults_t faults = {};
+        faults.byte_time_us            = byte_time_us;
+        faults.advance_timer           = true;
+        split_loopback_set_faults(&faults);
+        // Long enough for the measurement to settle, even while the budget still holds the display back
+        for (int i = 0; i < 20000; ++i) {
+            scribble();
+            cycle();
+        }
+    }
+
+    // Redraws the whole master display with noise, which doesn't compress
+    void scribble() {
+        for (uint16_t index = 0; index < OLED_MATRIX_SIZE; ++index) {
+            noise                    = noise * 1103515245 + 12345;
+            display_buffer[0][index] = noise >> 16;
+        }
+        display_changed[0] = ~(OLED_BLOCK_TYPE)0;
+    }
+
+    bool mirrored() {
+        split_loopback_slave(slave_remote, slave_local);
+        return memcmp(display_buffer[0], display_buffer[1], OLED_MATRIX_SIZE) == 0;
+    }
+};
+
+TEST_F(SplitSyncScheduler, ThroughputIsMeasured) {
+    link(100);
+    EXPECT_NEAR(split_sync_get_stats()->bytes_per_ms, 10, 1);
+    EXPECT_EQ(split_sync_get_stats()->budget_bytes, split_sync_get_stats()->bytes_per_ms);
+
+    link(2);
+    EXPECT_NEAR(split_sync_get_stats()->bytes_per_ms, 500, 25);
+}
+
+TEST_F(SplitSyncScheduler, InputIsNotHeldUpOnASlowLink) {
+    // A one millisecond budget is ten bytes here, not even enough for a single display frame
+    link(100);
+    const split_sync_stats_t *stats  = split_sync_get_stats();
+    uint32_t                  forced = stats->forced;
+    uint32_t                  over   = 0;
+    uint32_t                  start  = timer_read32();
+
+    for (int i = 0; i < 500; ++i) {
+        scribble();
+        slave_local[0] = i & 0x03FF;
+        EXPECT_TRUE(cycle());
+        EXPECT_EQ(master_remote[0], slave_local[0]);
+        over += stats->cycle_bytes > stats->budget_bytes;
+    }
+    // Only starved handlers go over, one per cycle, and the display still gets its minimum rate
+    EXPECT_GT(stats->forced, forced);
+    EXPECT_LE(over, stats->forced - forced);
+    EXPECT_LE(stats->forced - forced, 2 * (timer_elapsed32(start) / 10 + 1));
+}
+
+TEST_F(SplitSyncScheduler, CosmeticDataUsesTheLeftoverBudget) {
+    // Plenty of room for a display frame on every cycle, but it is sent at most every 10ms
+    link(2);
+    const split_sync_stats_t *stats    = split_sync_get_stats();
+    uint32_t                  forced   = stats->forced;
+    uint32_t                  deferred = stats->deferred;
+
+    scribble();
+    for (int i = 0; i < OLED_BLOCK_COUNT * 10 + 10; ++i) {
+        EXPECT_TRUE(cycle());
+    }
+    EXPECT_TRUE(mirrored());
+    EXPECT_EQ(stats->forced, forced);
+    EXPECT_GT(stats->deferred, deferred);
+}
+#endif // SPLIT_SYNC_SCHEDULER_ENABLE
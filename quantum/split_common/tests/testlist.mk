@@ -0,0 +1,8 @@
+TEST_LIST += \
+	split_transactions \
+	split_transactions_batch \
+	split_transactions_events \
+	split_transactions_oled \
+	split_transactions_pointing \
+	split_transactions_rpc \
+	split_transactions_scheduler
@@ -24,6 +24,11 @@ enum serial_transaction_id {
     GET_SLAVE_MATRIX_CHECKSUM,
     GET_SLAVE_MATRIX_DATA,
 
+#ifdef SPLIT_SLAVE_EVENTS_ENABLE
+    GET_SLAVE_EVENT_COUNT,
+    GET_SLAVE_EVENT_DATA,
+#endif // SPLIT_SLAVE_EVENTS_ENABLE
+
 #ifdef SPLIT_TRANSPORT_MIRROR
     PUT_MASTER_MATRIX,
 #endif // SPLIT_TRANSPORT_MIRROR
@@ -64,6 +69,9 @@ enum serial_transaction_id {
 
 #if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
     PUT_RGB_MATRIX,
+#    ifdef RGB_MATRIX_SPLIT_LOCKSTEP
+    PUT_RGB_MATRIX_LOCKSTEP,
+#    endif // RGB_MATRIX_SPLIT_LOCKSTEP
 #endif // defined(RGBLIGHT_ENABLE) && defined(RGBLIGHT_SPLIT)
 
 #if defined(WPM_ENABLE) && defined(SPLIT_WPM_ENABLE)
@@ -72,19 +80,36 @@ enum serial_transaction_id {
 
 #if defined(OLED_ENABLE) && defined(SPLIT_OLED_ENABLE)
     PUT_OLED,
-#endif // defined(OLED_ENABLE) && defined(SPLIT_OLED_ENABLE)
+#    ifdef SPLIT_OLED_MIRROR_ENABLE
+    PUT_OLED_MIRROR_LENGTH,
+    PUT_OLED_MIRROR,
+#    endif // SPLIT_OLED_MIRROR_ENABLE
+#endif     // defined(OLED_ENABLE) && defined(SPLIT_OLED_ENABLE)
 
 #if defined(ST7565_ENABLE) && defined(SPLIT_ST7565_ENABLE)
     PUT_ST7565,
-#endif // defined(ST7565_ENABLE) && defined(SPLIT_ST7565_ENABLE)
+#    ifdef SPLIT_ST7565_MIRROR_ENABLE
+    PUT_ST7565_MIRROR_LENGTH,
+    PUT_ST7565_MIRROR,
+#    endif // SPLIT_ST7565_MIRROR_ENABLE
+#endif     // defined(ST7565_ENABLE) && defined(SPLIT_ST7565_ENABLE)
 
 #if defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
-    GET_POINTING_CHECKSUM,
     GET_POINTING_DATA,
     PUT_POINTING_CPI,
+    PUT_POINTING_EPOCH,
 #endif // defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
 
+#ifdef SPLIT_TRANSACTION_BATCH
+    BATCH_EXCHANGE,
+#endif // SPLIT_TRANSACTION_BATCH
+
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
+#    ifdef SPLIT_RPC_QUEUE_ENABLE
+    PUT_RPC_QUEUE_INFO,
+    PUT_RPC_QUEUE_DATA,
+    GET_RPC_QUEUE_RESULT,
+#    endif // SPLIT_RPC_QUEUE_ENABLE
     PUT_RPC_INFO,
     PUT_RPC_REQ_DATA,
     EXECUTE_RPC,
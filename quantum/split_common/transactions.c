@@ -42,15 +42,70 @@
     { 0, 0, sizeof_member(split_shared_memory_t, member), offsetof(split_shared_memory_t, member), cb }
 #define trans_target2initiator_initializer(member) trans_target2initiator_initializer_cb(member, NULL)
 
-#define transport_write(id, data, length) transport_execute_transaction(id, data, length, NULL, 0)
-#define transport_read(id, data, length) transport_execute_transaction(id, NULL, 0, data, length)
+#define trans_bidirectional_initializer_cb(initiator2target_member, target2initiator_member, cb) \
+    { sizeof_member(split_shared_memory_t, initiator2target_member), offsetof(split_shared_memory_t, initiator2target_member), sizeof_member(split_shared_memory_t, target2initiator_member), offsetof(split_shared_memory_t, target2initiator_member), cb }
+
+#ifdef SPLIT_TRANSACTION_BATCH
+static bool batch_write(int8_t id, const void *data, size_t length);
+#    define transport_write(id, data, length) batch_write(id, data, length)
+#    define transport_read(id, data, length) transport_execute_transaction(id, NULL, 0, data, length)
+#elif defined(SPLIT_SYNC_SCHEDULER_ENABLE)
+static bool sync_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length);
+#    define transport_write(id, data, length) sync_transaction(id, data, length, NULL, 0)
+#    define transport_read(id, data, length) sync_transaction(id, NULL, 0, data, length)
+#else
+#    define transport_write(id, data, length) transport_execute_transaction(id, data, length, NULL, 0)
+#    define transport_read(id, data, length) transport_execute_transaction(id, NULL, 0, data, length)
+#endif
 
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
 // Forward-declare the RPC callback handlers
 void slave_rpc_info_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer);
 void slave_rpc_exec_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer);
+#    ifdef SPLIT_RPC_QUEUE_ENABLE
+void        slave_rpc_queue_info_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer);
+void        slave_rpc_queue_exec_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer);
+static void rpc_queue_flush(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]);
+#        define TRANSACTIONS_RPC_QUEUE_MASTER() rpc_queue_flush(master_matrix, slave_matrix)
+#    endif // SPLIT_RPC_QUEUE_ENABLE
+#elif defined(SPLIT_RPC_QUEUE_ENABLE)
+#    error "SPLIT_RPC_QUEUE_ENABLE requires SPLIT_TRANSACTION_IDS_KB or SPLIT_TRANSACTION_IDS_USER"
 #endif // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
 
+#ifndef TRANSACTIONS_RPC_QUEUE_MASTER
+#    define TRANSACTIONS_RPC_QUEUE_MASTER()
+#endif // TRANSACTIONS_RPC_QUEUE_MASTER
+
+#ifdef SPLIT_SLAVE_EVENTS_ENABLE
+#    ifdef SPLIT_TRANSACTION_BATCH
+#        error "SPLIT_SLAVE_EVENTS_ENABLE cannot be combined with SPLIT_TRANSACTION_BATCH"
+#    endif
+// Set on the master when the slave has signalled pending input, or the heartbeat is due
+static bool slave_events_due = true;
+#endif // SPLIT_SLAVE_EVENTS_ENABLE
+
+#ifdef SPLIT_TRANSACTION_BATCH
+#    if defined(__AVR__) && !defined(USE_I2C)
+#        error "SPLIT_TRANSACTION_BATCH is not supported by the AVR bitbang serial driver, as it runs the slave callback before receiving the master's data"
+#    endif
+static split_batch_m2s_t batch_m2s;
+static uint8_t           batch_m2s_used  = 0;
+static int8_t            batch_last_put  = -1;
+static bool              batch_staging   = false;
+static uint32_t          batch_delivered = 0;
+#    ifdef SPLIT_TRANSACTION_ASYNC
+#        ifdef USE_I2C
+#            error "SPLIT_TRANSACTION_ASYNC is not supported with USE_I2C"
+#        endif
+static bool batch_in_flight = false;
+static bool batch_waiting   = false;
+#    endif // SPLIT_TRANSACTION_ASYNC
+#else      // SPLIT_TRANSACTION_BATCH
+#    ifdef SPLIT_TRANSACTION_ASYNC
+#        error "SPLIT_TRANSACTION_ASYNC requires SPLIT_TRANSACTION_BATCH"
+#    endif
+#endif // SPLIT_TRANSACTION_BATCH
+
 ////////////////////////////////////////////////////
 // Helpers
 
@@ -63,6 +118,10 @@ static bool transaction_handler_master(matrix_row_t master_matrix[], matrix_row_
             }
         }
         bool this_okay = true;
+#ifdef SPLIT_TRANSACTION_ASYNC
+        // A background frame has to clear the line first, and it can't be waited on inside the lock
+        transport_transaction_wait();
+#endif // SPLIT_TRANSACTION_ASYNC
         ATOMIC_BLOCK_FORCEON {
             this_okay = handler(master_matrix, slave_matrix);
         };
@@ -85,6 +144,30 @@ static bool transaction_handler_master(matrix_row_t master_matrix[], matrix_row_
     } while (0)
 
 inline static bool read_if_checksum_mismatch(int8_t trans_id_checksum, int8_t trans_id_retrieve, uint32_t *last_update, void *destination, const void *equiv_shmem, size_t length) {
+#ifdef SPLIT_TRANSACTION_BATCH
+    if (batch_delivered & (1UL << trans_id_retrieve)) {
+        // Already returned by the batched exchange, and validated by its frame checksum
+        memcpy(destination, equiv_shmem, length);
+        *last_update = timer_read32();
+        return true;
+    }
+#    ifdef SPLIT_TRANSACTION_ASYNC
+    if (batch_waiting) {
+        // The frame is still on the wire, keep the last-known data
+        memcpy(destination, equiv_shmem, length);
+        return true;
+    }
+#    endif // SPLIT_TRANSACTION_ASYNC
+#endif // SPLIT_TRANSACTION_BATCH
+
+#ifdef SPLIT_SLAVE_EVENTS_ENABLE
+    if (!slave_events_due) {
+        // Nothing pending on the slave, keep the last-known data
+        memcpy(destination, equiv_shmem, length);
+        return true;
+    }
+#endif // SPLIT_SLAVE_EVENTS_ENABLE
+
     uint8_t curr_checksum;
     bool    okay = transport_read(trans_id_checksum, &curr_checksum, sizeof(curr_checksum));
     if (okay && (timer_elapsed32(*last_update) >= FORCED_SYNC_THROTTLE_MS || curr_checksum != crc8(equiv_shmem, length))) {
@@ -99,6 +182,25 @@ inline static bool read_if_checksum_mismatch(int8_t trans_id_checksum, int8_t tr
     return okay;
 }
 
+// For slave data that is safe to read any number of times, skips the read when this cycle already has it
+inline static bool read_if_stale(int8_t trans_id, void *destination, const void *equiv_shmem, size_t length) {
+#ifdef SPLIT_TRANSACTION_BATCH
+    bool current = batch_delivered & (1UL << trans_id);
+#    ifdef SPLIT_TRANSACTION_ASYNC
+    current |= batch_waiting;
+#    endif // SPLIT_TRANSACTION_ASYNC
+#elif defined(SPLIT_SLAVE_EVENTS_ENABLE)
+    bool current = !slave_events_due;
+#else
+    bool current = false;
+#endif
+    if (current) {
+        memcpy(destination, equiv_shmem, length);
+        return true;
+    }
+    return transport_read(trans_id, destination, length);
+}
+
 inline static bool send_if_condition(int8_t trans_id, uint32_t *last_update, bool condition, void *source, size_t length) {
     bool okay = true;
     if (timer_elapsed32(*last_update) >= FORCED_SYNC_THROTTLE_MS || condition) {
@@ -115,9 +217,444 @@ inline static bool send_if_data_mismatch(int8_t trans_id, uint32_t *last_update,
     return send_if_condition(trans_id, last_update, (memcmp(source, equiv_shmem, length) != 0), source, length);
 }
 
+////////////////////////////////////////////////////
+// Sync scheduler
+
+#ifdef SPLIT_SYNC_SCHEDULER_ENABLE
+#    ifdef SPLIT_TRANSACTION_BATCH
+#        error "SPLIT_SYNC_SCHEDULER_ENABLE cannot be combined with SPLIT_TRANSACTION_BATCH"
+#    endif
+#    ifndef SPLIT_SYNC_BUDGET_US
+#        define SPLIT_SYNC_BUDGET_US 1000
+#    endif
+#    ifndef SPLIT_SYNC_INITIAL_BYTES_PER_MS
+#        define SPLIT_SYNC_INITIAL_BYTES_PER_MS 16
+#    endif
+#    ifndef SPLIT_SYNC_MEASURE_WINDOW_MS
+#        define SPLIT_SYNC_MEASURE_WINDOW_MS 50
+#    endif
+#    ifndef SPLIT_SYNC_STATE_MIN_INTERVAL_MS
+#        define SPLIT_SYNC_STATE_MIN_INTERVAL_MS 0
+#    endif
+#    ifndef SPLIT_SYNC_STATE_MAX_INTERVAL_MS
+#        define SPLIT_SYNC_STATE_MAX_INTERVAL_MS 10
+#    endif
+#    ifndef SPLIT_SYNC_COSMETIC_MIN_INTERVAL_MS
+#        define SPLIT_SYNC_COSMETIC_MIN_INTERVAL_MS 10
+#    endif
+#    ifndef SPLIT_SYNC_COSMETIC_MAX_INTERVAL_MS
+#        define SPLIT_SYNC_COSMETIC_MAX_INTERVAL_MS 250
+#    endif
+
+// Transaction ID and its acknowledgement
+#    define SYNC_HANDSHAKE_BYTES 2
+
+// Input (slave matrix, encoders, pointing device) is not scheduled, it goes first on every cycle
+enum sync_class { SYNC_CLASS_STATE, SYNC_CLASS_COSMETIC, NUM_SYNC_CLASSES };
+
+enum sync_slot {
+    SYNC_SLOT_MASTER_MATRIX,
+    SYNC_SLOT_SYNC_TIMER,
+    SYNC_SLOT_LAYER_STATE,
+    SYNC_SLOT_LED_STATE,
+    SYNC_SLOT_MODS,
+    SYNC_SLOT_BACKLIGHT,
+    SYNC_SLOT_RGBLIGHT,
+    SYNC_SLOT_LED_MATRIX,
+    SYNC_SLOT_RGB_MATRIX,
+    SYNC_SLOT_WPM,
+    SYNC_SLOT_OLED,
+    SYNC_SLOT_ST7565,
+    NUM_SYNC_SLOTS,
+};
+
+typedef struct sync_slot_state_t {
+    uint32_t last_sent;
+    uint16_t cost; // largest number of bytes the handlers have sent in one go
+} sync_slot_state_t;
+
+static const uint16_t sync_min_interval[NUM_SYNC_CLASSES] = {
+    [SYNC_CLASS_STATE]    = SPLIT_SYNC_STATE_MIN_INTERVAL_MS,
+    [SYNC_CLASS_COSMETIC] = SPLIT_SYNC_COSMETIC_MIN_INTERVAL_MS,
+};
+static const uint16_t sync_max_interval[NUM_SYNC_CLASSES] = {
+    [SYNC_CLASS_STATE]    = SPLIT_SYNC_STATE_MAX_INTERVAL_MS,
+    [SYNC_CLASS_COSMETIC] = SPLIT_SYNC_COSMETIC_MAX_INTERVAL_MS,
+};
+
+static sync_slot_state_t  sync_slots[NUM_SYNC_SLOTS];
+static split_sync_stats_t sync_stats = {
+    .bytes_per_ms = SPLIT_SYNC_INITIAL_BYTES_PER_MS,
+    .budget_bytes = (uint32_t)SPLIT_SYNC_INITIAL_BYTES_PER_MS * SPLIT_SYNC_BUDGET_US / 1000,
+};
+static uint32_t sync_cycle_start;
+static uint16_t sync_cycle_bytes;
+static bool     sync_cycle_forced;
+static bool     sync_slot_forced;
+static uint32_t sync_window_bytes;
+static uint32_t sync_window_ms;
+
+static bool sync_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length) {
+    // The transports move whole buffers, whatever the lengths asked for
+    split_transaction_desc_t *trans = &split_transaction_table[id];
+    sync_cycle_bytes += SYNC_HANDSHAKE_BYTES + trans->initiator2target_buffer_size + trans->target2initiator_buffer_size;
+    return transport_execute_transaction(id, initiator2target_buf, initiator2target_length, target2initiator_buf, target2initiator_length);
+}
+
+static void sync_cycle_begin(void) {
+    sync_cycle_start  = timer_read32();
+    sync_cycle_bytes  = 0;
+    sync_cycle_forced = false;
+}
+
+static void sync_cycle_end(void) {
+    sync_stats.cycle_bytes = sync_cycle_bytes;
+    if (!sync_cycle_bytes) return;
+
+    // Cycles start at random points within a timer tick, so the summed elapsed ticks average out to the time spent
+    sync_window_bytes += sync_cycle_bytes;
+    sync_window_ms += timer_elapsed32(sync_cycle_start);
+    if (sync_window_ms >= SPLIT_SYNC_MEASURE_WINDOW_MS) {
+        uint32_t measured = sync_window_bytes / sync_window_ms;
+        uint32_t smoothed = (sync_stats.bytes_per_ms + measured) / 2;
+        if (smoothed < 1) smoothed = 1;
+        if (smoothed > UINT16_MAX) smoothed = UINT16_MAX;
+        uint32_t budget = smoothed * SPLIT_SYNC_BUDGET_US / 1000;
+
+        sync_stats.bytes_per_ms = smoothed;
+        sync_stats.budget_bytes = budget > UINT16_MAX ? UINT16_MAX : budget;
+        sync_window_bytes       = 0;
+        sync_window_ms          = 0;
+    }
+}
+
+static bool sync_slot_due(uint8_t slot, uint8_t sync_class) {
+    uint32_t elapsed = timer_elapsed32(sync_slots[slot].last_sent);
+    if (elapsed >= sync_min_interval[sync_class]) {
+        // Handlers that never sent anything are let through to find out what they cost
+        if (!sync_slots[slot].cost || (uint32_t)sync_cycle_bytes + sync_slots[slot].cost <= sync_stats.budget_bytes) {
+            return true;
+        }
+        // Let one starved handler through on each cycle, whatever the budget
+        if (elapsed >= sync_max_interval[sync_class] && !sync_cycle_forced) {
+            sync_slot_forced = true;
+            return true;
+        }
+    }
+    sync_stats.deferred++;
+    return false;
+}
+
+static void sync_slot_done(uint8_t slot, uint16_t bytes_before) {
+    uint16_t cost = sync_cycle_bytes - bytes_before;
+    if (cost) {
+        sync_slots[slot].last_sent = timer_read32();
+        if (cost > sync_slots[slot].cost) {
+            sync_slots[slot].cost = cost;
+        }
+        if (sync_slot_forced) {
+            sync_cycle_forced = true;
+            sync_stats.forced++;
+        }
+    }
+    sync_slot_forced = false;
+}
+
+const split_sync_stats_t *split_sync_get_stats(void) {
+    return &sync_stats;
+}
+
+#    define TRANSACTIONS_SCHEDULED(sync_class, feature)                        \
+        do {                                                                   \
+            if (sync_slot_due(SYNC_SLOT_##feature, SYNC_CLASS_##sync_class)) { \
+                uint16_t bytes_before = sync_cycle_bytes;                      \
+                TRANSACTIONS_##feature##_MASTER();                             \
+                sync_slot_done(SYNC_SLOT_##feature, bytes_before);             \
+            }                                                                  \
+        } while (0)
+
+#else // SPLIT_SYNC_SCHEDULER_ENABLE
+
+#    define TRANSACTIONS_SCHEDULED(sync_class, feature) TRANSACTIONS_##feature##_MASTER()
+
+#endif // SPLIT_SYNC_SCHEDULER_ENABLE
+
+////////////////////////////////////////////////////
+// Batched exchange
+
+#ifdef SPLIT_TRANSACTION_BATCH
+
+static bool batch_write(int8_t id, const void *data, size_t length) {
+    if (batch_staging) {
+        split_transaction_desc_t *trans = &split_transaction_table[id];
+        uint8_t                   len   = trans->initiator2target_buffer_size;
+        // Regions must be packed in ascending ID order, so that the slave can unpack them using the mask alone
+        if (id > batch_last_put && length >= len && batch_m2s_used + len <= sizeof(batch_m2s.payload)) {
+            memcpy(&batch_m2s.payload[batch_m2s_used], data, len);
+            // Mirror what the transport does, so that later mismatch checks compare against the staged data
+            memcpy(split_trans_initiator2target_buffer(trans), data, len);
+            batch_m2s.put_mask |= (1UL << id);
+            batch_m2s_used += len;
+            batch_last_put = id;
+            return true;
+        }
+    }
+    // Not staging, or the region doesn't fit in the frame -- send it on its own
+    return transport_execute_transaction(id, data, length, NULL, 0);
+}
+
+static void batch_begin(void) {
+    batch_m2s.put_mask = 0;
+    batch_m2s.get_mask = (1UL << GET_SLAVE_MATRIX_DATA);
+#    ifdef ENCODER_ENABLE
+    batch_m2s.get_mask |= (1UL << GET_ENCODERS_DATA);
+#    endif // ENCODER_ENABLE
+#    if defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+    batch_m2s.get_mask |= (1UL << GET_POINTING_DATA);
+#    endif // defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+    batch_m2s_used  = 0;
+    batch_last_put  = -1;
+    batch_delivered = 0;
+    batch_staging   = true;
+}
+
+static bool batch_unpack_response(const split_batch_s2m_t *response) {
+    if (response->checksum != crc8(response, offsetof(split_batch_s2m_t, checksum))) {
+        return false;
+    }
+
+    // Unpack the returned regions into their usual shmem locations
+    uint8_t used = 0;
+    for (int8_t id = 0; id < NUM_TOTAL_TRANSACTIONS; ++id) {
+        if (response->mask & (1UL << id)) {
+            split_transaction_desc_t *trans = &split_transaction_table[id];
+            if (used + trans->target2initiator_buffer_size > sizeof(response->payload)) {
+                return false;
+            }
+            memcpy(split_trans_target2initiator_buffer(trans), &response->payload[used], trans->target2initiator_buffer_size);
+            used += trans->target2initiator_buffer_size;
+        }
+    }
+    batch_delivered = response->mask;
+    return true;
+}
+
+#    ifndef SPLIT_TRANSACTION_ASYNC
+static bool batch_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    split_batch_s2m_t response;
+    if (!transport_execute_transaction(BATCH_EXCHANGE, &batch_m2s, sizeof(batch_m2s), &response, sizeof(response))) {
+        return false;
+    }
+    return batch_unpack_response(&response);
+}
+#    endif // SPLIT_TRANSACTION_ASYNC
+
+static void slave_batch_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
+    const split_batch_m2s_t *m2s = (const split_batch_m2s_t *)initiator2target_buffer;
+    split_batch_s2m_t *      s2m = (split_batch_s2m_t *)target2initiator_buffer;
+
+    // Scatter the received regions, the regular slave handlers then act on them as usual
+    uint8_t used = 0;
+    for (int8_t id = 0; id < NUM_TOTAL_TRANSACTIONS; ++id) {
+        if (m2s->put_mask & (1UL << id)) {
+            split_transaction_desc_t *trans = &split_transaction_table[id];
+            if (used + trans->initiator2target_buffer_size > sizeof(m2s->payload)) {
+                break;
+            }
+            memcpy(split_trans_initiator2target_buffer(trans), &m2s->payload[used], trans->initiator2target_buffer_size);
+            used += trans->initiator2target_buffer_size;
+        }
+    }
+
+    // Gather whatever was requested and fits, the master falls back to regular transactions for the rest
+    s2m->mask = 0;
+    used      = 0;
+    for (int8_t id = 0; id < NUM_TOTAL_TRANSACTIONS; ++id) {
+        if (m2s->get_mask & (1UL << id)) {
+            split_transaction_desc_t *trans = &split_transaction_table[id];
+            if (used + trans->target2initiator_buffer_size <= sizeof(s2m->payload)) {
+                memcpy(&s2m->payload[used], split_trans_target2initiator_buffer(trans), trans->target2initiator_buffer_size);
+                used += trans->target2initiator_buffer_size;
+                s2m->mask |= (1UL << id);
+            }
+        }
+    }
+    s2m->checksum = crc8(s2m, offsetof(split_batch_s2m_t, checksum));
+}
+
+#    define TRANSACTIONS_BATCH_REGISTRATIONS [BATCH_EXCHANGE] = trans_bidirectional_initializer_cb(batch_m2s, batch_s2m, slave_batch_callback),
+
+#else // SPLIT_TRANSACTION_BATCH
+
+#    define TRANSACTIONS_BATCH_REGISTRATIONS
+
+#endif // SPLIT_TRANSACTION_BATCH
+
 ////////////////////////////////////////////////////
 // Slave matrix
 
+#ifdef SPLIT_SLAVE_EVENTS_ENABLE
+
+static split_key_edge_t slave_edge_queue[SPLIT_SLAVE_EVENT_BUFFER_SIZE];
+static uint8_t          slave_edge_count    = 0;
+static bool             slave_edge_overflow = false;
+
+static void slave_events_signal(void) {
+#    ifdef SPLIT_SLAVE_EVENT_PIN
+    writePinLow(SPLIT_SLAVE_EVENT_PIN);
+#    endif // SPLIT_SLAVE_EVENT_PIN
+}
+
+static bool slave_events_signalled(void) {
+#    ifdef SPLIT_SLAVE_EVENT_PIN
+    static uint32_t last_heartbeat = 0;
+    if (!readPin(SPLIT_SLAVE_EVENT_PIN) || timer_elapsed32(last_heartbeat) >= SPLIT_SLAVE_EVENT_HEARTBEAT_MS) {
+        last_heartbeat = timer_read32();
+        return true;
+    }
+    return false;
+#    else
+    // Without a signal line, the edge count is polled every scan instead of the matrix checksum
+    return true;
+#    endif // SPLIT_SLAVE_EVENT_PIN
+}
+
+// Applies edges in order, stopping at the first key that already changed in this pass so that quick taps survive.
+// Returns the number of edges left over for the next scan.
+static uint8_t slave_matrix_apply_edges(matrix_row_t matrix[], split_key_edge_t edges[], uint8_t count) {
+    matrix_row_t changed[(MATRIX_ROWS) / 2] = {0};
+    uint8_t      i                          = 0;
+    for (; i < count; ++i) {
+        uint8_t row = edges[i].row;
+        uint8_t col = edges[i].col & ~SPLIT_KEY_EDGE_PRESSED;
+        if (row >= (MATRIX_ROWS) / 2 || col >= MATRIX_COLS) {
+            continue;
+        }
+        matrix_row_t mask = MATRIX_ROW_SHIFTER << col;
+        if (changed[row] & mask) {
+            break;
+        }
+        changed[row] |= mask;
+        if (edges[i].col & SPLIT_KEY_EDGE_PRESSED) {
+            matrix[row] |= mask;
+        } else {
+            matrix[row] &= ~mask;
+        }
+    }
+    memmove(edges, &edges[i], (count - i) * sizeof(split_key_edge_t));
+    return count - i;
+}
+
+static bool slave_matrix_read_snapshot(matrix_row_t matrix[]) {
+    uint8_t      checksum;
+    matrix_row_t temp_matrix[(MATRIX_ROWS) / 2];
+    bool         okay = transport_read(GET_SLAVE_MATRIX_CHECKSUM, &checksum, sizeof(checksum));
+    okay &= transport_read(GET_SLAVE_MATRIX_DATA, temp_matrix, sizeof(temp_matrix));
+    okay &= checksum == crc8(temp_matrix, sizeof(temp_matrix));
+    if (okay) {
+        memcpy(matrix, temp_matrix, sizeof(temp_matrix));
+    }
+    return okay;
+}
+
+static bool slave_matrix_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    static uint32_t         last_verify                    = 0;
+    static matrix_row_t     last_matrix[(MATRIX_ROWS) / 2] = {0};
+    static split_key_edge_t pending[SPLIT_SLAVE_EVENT_BUFFER_SIZE];
+    static uint8_t          pending_count = 0;
+    static bool             resync        = true;
+
+    bool okay = true;
+    if (pending_count > 0) {
+        // Finish off edges held back from the last scan before fetching any more
+        pending_count = slave_matrix_apply_edges(last_matrix, pending, pending_count);
+    } else if (slave_events_due) {
+        split_slave_events_sync_t events;
+        okay          = transport_read(GET_SLAVE_EVENT_COUNT, &events, offsetof(split_slave_events_sync_t, edges));
+        uint8_t count = events.count;
+        if (okay && count > 0 && count <= SPLIT_SLAVE_EVENT_BUFFER_SIZE) {
+            split_transaction_table[GET_SLAVE_EVENT_DATA].target2initiator_buffer_size = count * sizeof(split_key_edge_t);
+            okay = transport_read(GET_SLAVE_EVENT_DATA, events.edges, count * sizeof(split_key_edge_t));
+        }
+        if (okay && count <= SPLIT_SLAVE_EVENT_BUFFER_SIZE) {
+            // Count and edges are checked together, a corrupted count would otherwise lose or invent edges
+            okay = events.checksum == crc8(&events.count, sizeof(events.count) + count * sizeof(split_key_edge_t));
+        }
+        if (okay && count > 0 && count <= SPLIT_SLAVE_EVENT_BUFFER_SIZE) {
+            memcpy(pending, events.edges, count * sizeof(split_key_edge_t));
+            pending_count = slave_matrix_apply_edges(last_matrix, pending, count);
+        } else if (okay && count > 0) {
+            // The slave dropped edges, fall back to the full matrix
+            resync = true;
+        } else if (okay && timer_elapsed32(last_verify) >= FORCED_SYNC_THROTTLE_MS) {
+            // Idle, so the slave's snapshot should match what has been built from the edges
+            uint8_t checksum;
+            okay = transport_read(GET_SLAVE_MATRIX_CHECKSUM, &checksum, sizeof(checksum));
+            if (okay) {
+                resync |= checksum != crc8(last_matrix, sizeof(last_matrix));
+                last_verify = timer_read32();
+            }
+        }
+        // Drained edges are gone from the slave, so any failure needs the snapshot to recover
+        resync |= !okay;
+    }
+
+    if (resync && pending_count == 0 && okay) {
+        okay = slave_matrix_read_snapshot(last_matrix);
+        resync = !okay;
+    }
+
+    memcpy(slave_matrix, last_matrix, sizeof(last_matrix));
+    return okay;
+}
+
+static void slave_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    // The shmem snapshot still holds the previous scan, so any difference is a new edge
+    for (uint8_t row = 0; row < (MATRIX_ROWS) / 2; ++row) {
+        matrix_row_t changes = slave_matrix[row] ^ split_shmem->smatrix.matrix[row];
+        for (uint8_t col = 0; changes && col < MATRIX_COLS; ++col) {
+            matrix_row_t mask = MATRIX_ROW_SHIFTER << col;
+            if (changes & mask) {
+                changes &= ~mask;
+                if (slave_edge_count < SPLIT_SLAVE_EVENT_BUFFER_SIZE) {
+                    slave_edge_queue[slave_edge_count].row = row;
+                    slave_edge_queue[slave_edge_count].col = col | ((slave_matrix[row] & mask) ? SPLIT_KEY_EDGE_PRESSED : 0);
+                    slave_edge_count++;
+                } else {
+                    slave_edge_overflow = true;
+                }
+                slave_events_signal();
+            }
+        }
+    }
+    memcpy(split_shmem->smatrix.matrix, slave_matrix, sizeof(split_shmem->smatrix.matrix));
+    split_shmem->smatrix.checksum = crc8(split_shmem->smatrix.matrix, sizeof(split_shmem->smatrix.matrix));
+}
+
+static void slave_events_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
+    // Hand over everything queued so far, the master reads the edges with the following transaction
+    uint8_t count = slave_edge_overflow ? 0 : slave_edge_count;
+    memcpy(split_shmem->events.edges, slave_edge_queue, count * sizeof(split_key_edge_t));
+    split_shmem->events.count                                                  = slave_edge_overflow ? SPLIT_SLAVE_EVENTS_OVERFLOW : count;
+    split_shmem->events.checksum                                               = crc8(&split_shmem->events.count, sizeof(split_shmem->events.count) + count * sizeof(split_key_edge_t));
+    split_transaction_table[GET_SLAVE_EVENT_DATA].target2initiator_buffer_size = count * sizeof(split_key_edge_t);
+    slave_edge_count                                                           = 0;
+    slave_edge_overflow                                                        = false;
+#    ifdef SPLIT_SLAVE_EVENT_PIN
+    writePinHigh(SPLIT_SLAVE_EVENT_PIN);
+#    endif // SPLIT_SLAVE_EVENT_PIN
+}
+
+// clang-format off
+#define TRANSACTIONS_SLAVE_MATRIX_REGISTRATIONS \
+    [GET_SLAVE_MATRIX_CHECKSUM] = trans_target2initiator_initializer(smatrix.checksum), \
+    [GET_SLAVE_MATRIX_DATA]     = trans_target2initiator_initializer(smatrix.matrix), \
+    [GET_SLAVE_EVENT_COUNT]     = { 0, 0, offsetof(split_slave_events_sync_t, edges), offsetof(split_shared_memory_t, events), slave_events_callback }, \
+    [GET_SLAVE_EVENT_DATA]      = trans_target2initiator_initializer(events.edges),
+// clang-format on
+
+#else // SPLIT_SLAVE_EVENTS_ENABLE
+
 static bool slave_matrix_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     static uint32_t     last_update                    = 0;
     static matrix_row_t last_matrix[(MATRIX_ROWS) / 2] = {0}; // last successfully-read matrix, so we can replicate if there are checksum errors
@@ -139,13 +676,16 @@ static void slave_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row
 }
 
 // clang-format off
-#define TRANSACTIONS_SLAVE_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER(slave_matrix)
-#define TRANSACTIONS_SLAVE_MATRIX_SLAVE() TRANSACTION_HANDLER_SLAVE(slave_matrix)
 #define TRANSACTIONS_SLAVE_MATRIX_REGISTRATIONS \
     [GET_SLAVE_MATRIX_CHECKSUM] = trans_target2initiator_initializer(smatrix.checksum), \
     [GET_SLAVE_MATRIX_DATA]     = trans_target2initiator_initializer(smatrix.matrix),
 // clang-format on
 
+#endif // SPLIT_SLAVE_EVENTS_ENABLE
+
+#define TRANSACTIONS_SLAVE_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER(slave_matrix)
+#define TRANSACTIONS_SLAVE_MATRIX_SLAVE() TRANSACTION_HANDLER_SLAVE(slave_matrix)
+
 ////////////////////////////////////////////////////
 // Master matrix
 
@@ -190,6 +730,11 @@ static bool encoder_handlers_master(matrix_row_t master_matrix[], matrix_row_t s
 static void encoder_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     uint8_t encoder_state[NUMBER_OF_ENCODERS];
     encoder_state_raw(encoder_state);
+#    ifdef SPLIT_SLAVE_EVENTS_ENABLE
+    if (memcmp(split_shmem->encoders.state, encoder_state, sizeof(encoder_state)) != 0) {
+        slave_events_signal();
+    }
+#    endif // SPLIT_SLAVE_EVENTS_ENABLE
     // Always prepare the encoder state for read.
     memcpy(split_shmem->encoders.state, encoder_state, sizeof(encoder_state));
     // Now update the checksum given that the encoders has been written to
@@ -477,17 +1022,41 @@ static bool rgb_matrix_handlers_master(matrix_row_t master_matrix[], matrix_row_
     rgb_matrix_sync_t rgb_matrix_sync;
     memcpy(&rgb_matrix_sync.rgb_matrix, &rgb_matrix_config, sizeof(rgb_config_t));
     rgb_matrix_sync.rgb_suspend_state = rgb_matrix_get_suspend_state();
-    return send_if_data_mismatch(PUT_RGB_MATRIX, &last_update, &rgb_matrix_sync, &split_shmem->rgb_matrix_sync, sizeof(rgb_matrix_sync));
+    bool okay                         = send_if_data_mismatch(PUT_RGB_MATRIX, &last_update, &rgb_matrix_sync, &split_shmem->rgb_matrix_sync, sizeof(rgb_matrix_sync));
+#    ifdef RGB_MATRIX_SPLIT_LOCKSTEP
+    // Keep the slave's frame clock trimmed, and pass on new hits straight away
+    static uint32_t       last_lockstep_update = 0;
+    rgb_matrix_lockstep_t lockstep;
+    rgb_matrix_lockstep_get(&lockstep);
+    bool due = timer_elapsed32(last_lockstep_update) >= RGB_MATRIX_SPLIT_LOCKSTEP_INTERVAL;
+#        ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
+    due |= lockstep.hit_sequence != split_shmem->rgb_matrix_lockstep.hit_sequence;
+#        endif // RGB_MATRIX_KEYREACTIVE_ENABLED
+    okay &= send_if_condition(PUT_RGB_MATRIX_LOCKSTEP, &last_lockstep_update, due, &lockstep, sizeof(lockstep));
+#    endif // RGB_MATRIX_SPLIT_LOCKSTEP
+    return okay;
 }
 
 static void rgb_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     memcpy(&rgb_matrix_config, &split_shmem->rgb_matrix_sync.rgb_matrix, sizeof(rgb_config_t));
     rgb_matrix_set_suspend_state(split_shmem->rgb_matrix_sync.rgb_suspend_state);
+#    ifdef RGB_MATRIX_SPLIT_LOCKSTEP
+    // Only act on each update once, as every update trims the clock
+    static rgb_matrix_lockstep_t last_lockstep = {0};
+    if (memcmp(&last_lockstep, &split_shmem->rgb_matrix_lockstep, sizeof(last_lockstep)) != 0) {
+        memcpy(&last_lockstep, &split_shmem->rgb_matrix_lockstep, sizeof(last_lockstep));
+        rgb_matrix_lockstep_apply(&last_lockstep);
+    }
+#    endif // RGB_MATRIX_SPLIT_LOCKSTEP
 }
 
 #    define TRANSACTIONS_RGB_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER(rgb_matrix)
 #    define TRANSACTIONS_RGB_MATRIX_SLAVE() TRANSACTION_HANDLER_SLAVE(rgb_matrix)
-#    define TRANSACTIONS_RGB_MATRIX_REGISTRATIONS [PUT_RGB_MATRIX] = trans_initiator2target_initializer(rgb_matrix_sync),
+#    ifdef RGB_MATRIX_SPLIT_LOCKSTEP
+#        define TRANSACTIONS_RGB_MATRIX_REGISTRATIONS [PUT_RGB_MATRIX] = trans_initiator2target_initializer(rgb_matrix_sync), [PUT_RGB_MATRIX_LOCKSTEP] = trans_initiator2target_initializer(rgb_matrix_lockstep),
+#    else
+#        define TRANSACTIONS_RGB_MATRIX_REGISTRATIONS [PUT_RGB_MATRIX] = trans_initiator2target_initializer(rgb_matrix_sync),
+#    endif // RGB_MATRIX_SPLIT_LOCKSTEP
 
 #else // defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
 
@@ -524,6 +1093,166 @@ static void wpm_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_
 
 #endif // defined(WPM_ENABLE) && defined(SPLIT_WPM_ENABLE)
 
+////////////////////////////////////////////////////
+// Display mirroring
+
+#if defined(SPLIT_OLED_MIRROR_ENABLE) || defined(SPLIT_ST7565_MIRROR_ENABLE)
+
+typedef struct display_mirror_state_t {
+    uint32_t pending; // blocks not yet sent to the slave
+    uint32_t last_refresh;
+    uint8_t  next_block;
+    uint8_t  refresh_block;
+    uint8_t  sequence;
+} display_mirror_state_t;
+
+// Each block is a sequence of control bytes: below 0x80, that many plus one literal bytes follow,
+// from 0x80, the single byte that follows is repeated (control & 0x7F) plus one times.
+// Returns the bytes used, or 0 if the block doesn't fit in the space left.
+static uint8_t display_mirror_encode_block(uint8_t *out, uint8_t space, const uint8_t *block, uint16_t size) {
+    uint8_t  used = 0;
+    uint16_t i    = 0;
+    while (i < size) {
+        uint16_t run = 1;
+        while (i + run < size && run < 128 && block[i + run] == block[i]) {
+            run++;
+        }
+        if (run >= 3) {
+            if (used + 2 > space) {
+                return 0;
+            }
+            out[used++] = 0x80 | (run - 1);
+            out[used++] = block[i];
+            i += run;
+        } else {
+            // Literal bytes, up to the next run worth encoding
+            uint16_t start = i;
+            uint8_t  count = 0;
+            while (i < size && count < 128 && !(i + 2 < size && block[i] == block[i + 1] && block[i] == block[i + 2])) {
+                i++;
+                count++;
+            }
+            if (used + 1 + count > space) {
+                return 0;
+            }
+            out[used++] = count - 1;
+            memcpy(&out[used], &block[start], count);
+            used += count;
+        }
+    }
+    return used;
+}
+
+// Writes a block out through the display's raw byte writer, so that its own dirty tracking picks it up.
+// Returns the bytes consumed, or 0 if the data is malformed.
+static uint8_t display_mirror_decode_block(const uint8_t *in, uint8_t length, uint16_t offset, uint16_t size, void (*write_byte)(const char data, uint16_t index)) {
+    uint8_t  used    = 0;
+    uint16_t written = 0;
+    while (written < size) {
+        if (used >= length) {
+            return 0;
+        }
+        uint8_t  control = in[used++];
+        uint16_t count   = (control & 0x7F) + 1;
+        if (written + count > size || used + ((control & 0x80) ? 1 : count) > length) {
+            return 0;
+        }
+        for (uint16_t i = 0; i < count; i++) {
+            write_byte((control & 0x80) ? in[used] : in[used + i], offset + written + i);
+        }
+        used += (control & 0x80) ? 1 : count;
+        written += count;
+    }
+    return used;
+}
+
+static uint8_t display_mirror_checksum(const split_display_mirror_header_t *header, const uint8_t *data) {
+    uint8_t crc = crc8_init();
+    crc         = crc8_update(crc, &header->sequence, sizeof(header->sequence) + sizeof(header->length));
+    crc         = crc8_update(crc, data, header->length);
+    return crc8_final(crc);
+}
+
+// Packs as many pending blocks as fit in the frame, starting after the last block sent so that a
+// constantly changing block can't starve the others. Returns the blocks packed.
+static uint32_t display_mirror_pack(display_mirror_state_t *state, const uint8_t *buffer, uint8_t block_count, uint16_t block_size, split_display_mirror_header_t *header, uint8_t *data, uint8_t budget) {
+    if (timer_elapsed32(state->last_refresh) >= FORCED_SYNC_THROTTLE_MS) {
+        // Trickle every block through again over time, so that anything lost on the way heals by itself
+        state->pending |= (1UL << state->refresh_block);
+        state->refresh_block = (state->refresh_block + 1) % block_count;
+        state->last_refresh  = timer_read32();
+    }
+
+    // Everything is pending to begin with, as the slave's contents are unknown
+    state->pending &= (((1UL << (block_count - 1)) - 1) << 1) | 1;
+
+    uint32_t packed = 0;
+    uint8_t  used   = 0;
+    uint8_t  start  = state->next_block;
+    for (uint8_t i = 0; i < block_count && used < budget; i++) {
+        uint8_t block = (start + i) % block_count;
+        if (!(state->pending & (1UL << block))) {
+            continue;
+        }
+        uint8_t length = display_mirror_encode_block(&data[used + 1], budget - used - 1, &buffer[block * block_size], block_size);
+        if (!length) {
+            break;
+        }
+        data[used] = block;
+        used += 1 + length;
+        packed |= (1UL << block);
+        state->next_block = (block + 1) % block_count;
+    }
+
+    if (packed) {
+        header->sequence = ++state->sequence;
+        header->length   = used;
+        header->checksum = display_mirror_checksum(header, data);
+    }
+    return packed;
+}
+
+#    ifdef SPLIT_TRANSACTION_BATCH
+// The slave sizes the frame in a callback, which the batched exchange would only run after unpacking it
+#        define display_mirror_write(id, data, length) transport_execute_transaction(id, data, length, NULL, 0)
+#    else
+#        define display_mirror_write(id, data, length) transport_write(id, data, length)
+#    endif // SPLIT_TRANSACTION_BATCH
+
+// Sizes the frame transaction to the header and the used part of the data, on either half
+static void display_mirror_set_length(int8_t frame_id, uint8_t length, uint8_t budget) {
+    split_transaction_table[frame_id].initiator2target_buffer_size = sizeof(split_display_mirror_header_t) + (length < budget ? length : budget);
+}
+
+// Sends the data length ahead of the frame, so that only the used part of the frame goes over the wire
+static bool display_mirror_send(int8_t length_id, int8_t frame_id, const void *frame, uint8_t budget) {
+    const split_display_mirror_header_t *header = (const split_display_mirror_header_t *)frame;
+    display_mirror_set_length(frame_id, header->length, budget);
+    return display_mirror_write(length_id, &header->length, sizeof(header->length)) && display_mirror_write(frame_id, frame, split_transaction_table[frame_id].initiator2target_buffer_size);
+}
+
+// Applies a frame the first time it is seen, returns the sequence number to compare the next frame against
+static uint8_t display_mirror_unpack(uint8_t last_sequence, const split_display_mirror_header_t *header, const uint8_t *data, uint8_t budget, uint8_t block_count, uint16_t block_size, void (*write_byte)(const char data, uint16_t index)) {
+    if (header->sequence == last_sequence || header->length > budget || header->checksum != display_mirror_checksum(header, data)) {
+        return last_sequence;
+    }
+    uint8_t used = 0;
+    while (used < header->length) {
+        uint8_t block = data[used++];
+        if (block >= block_count) {
+            break;
+        }
+        uint8_t length = display_mirror_decode_block(&data[used], header->length - used, block * block_size, block_size, write_byte);
+        if (!length) {
+            break;
+        }
+        used += length;
+    }
+    return header->sequence;
+}
+
+#endif // defined(SPLIT_OLED_MIRROR_ENABLE) || defined(SPLIT_ST7565_MIRROR_ENABLE)
+
 ////////////////////////////////////////////////////
 // OLED
 
@@ -543,9 +1272,52 @@ static void oled_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave
     }
 }
 
-#    define TRANSACTIONS_OLED_MASTER() TRANSACTION_HANDLER_MASTER(oled)
-#    define TRANSACTIONS_OLED_SLAVE() TRANSACTION_HANDLER_SLAVE(oled)
-#    define TRANSACTIONS_OLED_REGISTRATIONS [PUT_OLED] = trans_initiator2target_initializer(current_oled_state),
+#    ifdef SPLIT_OLED_MIRROR_ENABLE
+_Static_assert(OLED_BLOCK_COUNT <= 32, "SPLIT_OLED_MIRROR_ENABLE supports up to 32 OLED blocks");
+_Static_assert(SPLIT_OLED_MIRROR_BUDGET <= 255 - sizeof(split_display_mirror_header_t), "SPLIT_OLED_MIRROR_BUDGET is too large for a single transaction");
+_Static_assert(SPLIT_OLED_MIRROR_BUDGET >= 1 + OLED_BLOCK_SIZE + (OLED_BLOCK_SIZE + 127) / 128, "SPLIT_OLED_MIRROR_BUDGET must fit at least one uncompressible OLED block");
+
+static display_mirror_state_t oled_mirror_state = {.pending = UINT32_MAX};
+
+static bool oled_mirror_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    split_oled_mirror_t frame;
+    oled_mirror_state.pending |= oled_take_changed_blocks();
+    uint32_t packed = display_mirror_pack(&oled_mirror_state, oled_read_raw(0).current_element, OLED_BLOCK_COUNT, OLED_BLOCK_SIZE, &frame.header, frame.data, sizeof(frame.data));
+    if (!packed) {
+        return true;
+    }
+    bool okay = display_mirror_send(PUT_OLED_MIRROR_LENGTH, PUT_OLED_MIRROR, &frame, sizeof(frame.data));
+    if (okay) {
+        oled_mirror_state.pending &= ~packed;
+    }
+    return okay;
+}
+
+static void slave_oled_mirror_length_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
+    display_mirror_set_length(PUT_OLED_MIRROR, split_shmem->oled_mirror_length, sizeof(split_shmem->oled_mirror.data));
+}
+
+static void oled_mirror_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    static uint8_t last_sequence = 0;
+    last_sequence                = display_mirror_unpack(last_sequence, &split_shmem->oled_mirror.header, split_shmem->oled_mirror.data, sizeof(split_shmem->oled_mirror.data), OLED_BLOCK_COUNT, OLED_BLOCK_SIZE, oled_write_raw_byte);
+}
+
+#        define TRANSACTIONS_OLED_MASTER()                 \
+            do {                                           \
+                TRANSACTION_HANDLER_MASTER(oled);          \
+                TRANSACTION_HANDLER_MASTER(oled_mirror);   \
+            } while (0)
+#        define TRANSACTIONS_OLED_SLAVE()                  \
+            do {                                           \
+                TRANSACTION_HANDLER_SLAVE(oled);           \
+                TRANSACTION_HANDLER_SLAVE(oled_mirror);    \
+            } while (0)
+#        define TRANSACTIONS_OLED_REGISTRATIONS [PUT_OLED] = trans_initiator2target_initializer(current_oled_state), [PUT_OLED_MIRROR_LENGTH] = trans_initiator2target_initializer_cb(oled_mirror_length, slave_oled_mirror_length_callback), [PUT_OLED_MIRROR] = trans_initiator2target_initializer(oled_mirror),
+#    else // SPLIT_OLED_MIRROR_ENABLE
+#        define TRANSACTIONS_OLED_MASTER() TRANSACTION_HANDLER_MASTER(oled)
+#        define TRANSACTIONS_OLED_SLAVE() TRANSACTION_HANDLER_SLAVE(oled)
+#        define TRANSACTIONS_OLED_REGISTRATIONS [PUT_OLED] = trans_initiator2target_initializer(current_oled_state),
+#    endif // SPLIT_OLED_MIRROR_ENABLE
 
 #else // defined(OLED_ENABLE) && defined(SPLIT_OLED_ENABLE)
 
@@ -574,9 +1346,52 @@ static void st7565_handlers_slave(matrix_row_t master_matrix[], matrix_row_t sla
     }
 }
 
-#    define TRANSACTIONS_ST7565_MASTER() TRANSACTION_HANDLER_MASTER(st7565)
-#    define TRANSACTIONS_ST7565_SLAVE() TRANSACTION_HANDLER_SLAVE(st7565)
-#    define TRANSACTIONS_ST7565_REGISTRATIONS [PUT_ST7565] = trans_initiator2target_initializer(current_st7565_state),
+#    ifdef SPLIT_ST7565_MIRROR_ENABLE
+_Static_assert(ST7565_BLOCK_COUNT <= 32, "SPLIT_ST7565_MIRROR_ENABLE supports up to 32 ST7565 blocks");
+_Static_assert(SPLIT_ST7565_MIRROR_BUDGET <= 255 - sizeof(split_display_mirror_header_t), "SPLIT_ST7565_MIRROR_BUDGET is too large for a single transaction");
+_Static_assert(SPLIT_ST7565_MIRROR_BUDGET >= 1 + ST7565_BLOCK_SIZE + (ST7565_BLOCK_SIZE + 127) / 128, "SPLIT_ST7565_MIRROR_BUDGET must fit at least one uncompressible ST7565 block");
+
+static display_mirror_state_t st7565_mirror_state = {.pending = UINT32_MAX};
+
+static bool st7565_mirror_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    split_st7565_mirror_t frame;
+    st7565_mirror_state.pending |= st7565_take_changed_blocks();
+    uint32_t packed = display_mirror_pack(&st7565_mirror_state, st7565_read_raw(0).current_element, ST7565_BLOCK_COUNT, ST7565_BLOCK_SIZE, &frame.header, frame.data, sizeof(frame.data));
+    if (!packed) {
+        return true;
+    }
+    bool okay = display_mirror_send(PUT_ST7565_MIRROR_LENGTH, PUT_ST7565_MIRROR, &frame, sizeof(frame.data));
+    if (okay) {
+        st7565_mirror_state.pending &= ~packed;
+    }
+    return okay;
+}
+
+static void slave_st7565_mirror_length_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
+    display_mirror_set_length(PUT_ST7565_MIRROR, split_shmem->st7565_mirror_length, sizeof(split_shmem->st7565_mirror.data));
+}
+
+static void st7565_mirror_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    static uint8_t last_sequence = 0;
+    last_sequence                = display_mirror_unpack(last_sequence, &split_shmem->st7565_mirror.header, split_shmem->st7565_mirror.data, sizeof(split_shmem->st7565_mirror.data), ST7565_BLOCK_COUNT, ST7565_BLOCK_SIZE, st7565_write_raw_byte);
+}
+
+#        define TRANSACTIONS_ST7565_MASTER()               \
+            do {                                           \
+                TRANSACTION_HANDLER_MASTER(st7565);        \
+                TRANSACTION_HANDLER_MASTER(st7565_mirror); \
+            } while (0)
+#        define TRANSACTIONS_ST7565_SLAVE()                \
+            do {                                           \
+                TRANSACTION_HANDLER_SLAVE(st7565);         \
+                TRANSACTION_HANDLER_SLAVE(st7565_mirror);  \
+            } while (0)
+#        define TRANSACTIONS_ST7565_REGISTRATIONS [PUT_ST7565] = trans_initiator2target_initializer(current_st7565_state), [PUT_ST7565_MIRROR_LENGTH] = trans_initiator2target_initializer_cb(st7565_mirror_length, slave_st7565_mirror_length_callback), [PUT_ST7565_MIRROR] = trans_initiator2target_initializer(st7565_mirror),
+#    else // SPLIT_ST7565_MIRROR_ENABLE
+#        define TRANSACTIONS_ST7565_MASTER() TRANSACTION_HANDLER_MASTER(st7565)
+#        define TRANSACTIONS_ST7565_SLAVE() TRANSACTION_HANDLER_SLAVE(st7565)
+#        define TRANSACTIONS_ST7565_REGISTRATIONS [PUT_ST7565] = trans_initiator2target_initializer(current_st7565_state),
+#    endif // SPLIT_ST7565_MIRROR_ENABLE
 
 #else // defined(ST7565_ENABLE) && defined(SPLIT_ST7565_ENABLE)
 
@@ -591,6 +1406,13 @@ static void st7565_handlers_slave(matrix_row_t master_matrix[], matrix_row_t sla
 
 #if defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
 
+// Any nonzero value, the slave reports zero until it has been told this one after booting
+#    define POINTING_MOTION_EPOCH 1
+
+static uint8_t pointing_motion_checksum(const split_pointing_motion_t *motion) {
+    return crc8(&motion->buttons, sizeof(split_pointing_motion_t) - offsetof(split_pointing_motion_t, buttons));
+}
+
 static bool pointing_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
 #    if defined(POINTING_DEVICE_LEFT)
     if (is_keyboard_left()) {
@@ -601,12 +1423,34 @@ static bool pointing_handlers_master(matrix_row_t master_matrix[], matrix_row_t
         return true;
     }
 #    endif
-    static uint32_t last_update = 0;
-    static uint16_t last_cpi    = 0;
-    report_mouse_t  temp_state;
-    uint16_t        temp_cpi;
-    bool            okay = read_if_checksum_mismatch(GET_POINTING_CHECKSUM, GET_POINTING_DATA, &last_update, &temp_state, &split_shmem->pointing.report, sizeof(temp_state));
-    if (okay) pointing_device_set_shared_report(temp_state);
+    static split_pointing_motion_t last_motion;
+    static bool                    motion_synced = false;
+    static uint16_t                last_cpi      = 0;
+    split_pointing_motion_t        motion;
+    uint16_t                       temp_cpi;
+    bool                           okay = read_if_stale(GET_POINTING_DATA, &motion, &split_shmem->pointing.motion, sizeof(motion));
+    okay                                = okay && motion.checksum == pointing_motion_checksum(&motion);
+    if (!is_transport_connected()) {
+        // Don't replay what was moved while the link was down, take the next totals as the new baseline
+        motion_synced = false;
+    }
+    if (okay) {
+        if (motion.epoch == 0 && last_motion.epoch != 0) {
+            // The slave restarted, and its totals with it
+            memset(&last_motion, 0, sizeof(last_motion));
+        }
+        if (motion_synced) {
+            // Unsigned differences of the wrapping totals, the pointing device task carries what doesn't fit in a report
+            pointing_device_add_shared_motion(motion.buttons, (int16_t)(motion.x - last_motion.x), (int16_t)(motion.y - last_motion.y), (int16_t)(motion.v - last_motion.v), (int16_t)(motion.h - last_motion.h));
+        }
+        last_motion   = motion;
+        motion_synced = true;
+        if (motion.epoch != POINTING_MOTION_EPOCH) {
+            // Until the slave echoes it, so that its next restart shows up as the epoch going back to zero
+            split_shmem->pointing.epoch = POINTING_MOTION_EPOCH;
+            okay                        = transport_write(PUT_POINTING_EPOCH, &split_shmem->pointing.epoch, sizeof(split_shmem->pointing.epoch));
+        }
+    }
     temp_cpi = pointing_device_get_shared_cpi();
     if (temp_cpi && memcmp(&last_cpi, &temp_cpi, sizeof(temp_cpi)) != 0) {
         memcpy(&split_shmem->pointing.cpi, &temp_cpi, sizeof(temp_cpi));
@@ -630,8 +1474,9 @@ static void pointing_handlers_slave(matrix_row_t master_matrix[], matrix_row_t s
         return;
     }
 #    endif
-    report_mouse_t temp_report;
-    uint16_t       temp_cpi;
+    report_mouse_t           temp_report;
+    uint16_t                 temp_cpi;
+    split_pointing_motion_t *motion = &split_shmem->pointing.motion;
 #    if (POINTING_DEVICE_TASK_THROTTLE_MS > 0)
     static uint32_t last_exec = 0;
     if (timer_elapsed32(last_exec) < POINTING_DEVICE_TASK_THROTTLE_MS) {
@@ -647,14 +1492,25 @@ static void pointing_handlers_slave(matrix_row_t master_matrix[], matrix_row_t s
     }
     memset(&temp_report, 0, sizeof(temp_report));
     temp_report = pointing_device_driver.get_report(temp_report);
-    memcpy(&split_shmem->pointing.report, &temp_report, sizeof(temp_report));
-    // Now update the checksum given that the pointing has been written to
-    split_shmem->pointing.checksum = crc8(&temp_report, sizeof(temp_report));
+    if (temp_report.x || temp_report.y || temp_report.v || temp_report.h || temp_report.buttons != motion->buttons) {
+        // Accumulate at the sensor rate, however long the master takes to come and read it
+        motion->buttons = temp_report.buttons;
+        motion->x += temp_report.x;
+        motion->y += temp_report.y;
+        motion->v += temp_report.v;
+        motion->h += temp_report.h;
+#    ifdef SPLIT_SLAVE_EVENTS_ENABLE
+        slave_events_signal();
+#    endif // SPLIT_SLAVE_EVENTS_ENABLE
+    }
+    motion->epoch = split_shmem->pointing.epoch;
+    // Now update the checksum given that the totals or the epoch may have been written to
+    motion->checksum = pointing_motion_checksum(motion);
 }
 
 #    define TRANSACTIONS_POINTING_MASTER() TRANSACTION_HANDLER_MASTER(pointing)
 #    define TRANSACTIONS_POINTING_SLAVE() TRANSACTION_HANDLER_SLAVE(pointing)
-#    define TRANSACTIONS_POINTING_REGISTRATIONS [GET_POINTING_CHECKSUM] = trans_target2initiator_initializer(pointing.checksum), [GET_POINTING_DATA] = trans_target2initiator_initializer(pointing.report), [PUT_POINTING_CPI] = trans_initiator2target_initializer(pointing.cpi),
+#    define TRANSACTIONS_POINTING_REGISTRATIONS [GET_POINTING_DATA] = trans_target2initiator_initializer(pointing.motion), [PUT_POINTING_CPI] = trans_initiator2target_initializer(pointing.cpi), [PUT_POINTING_EPOCH] = trans_initiator2target_initializer(pointing.epoch),
 
 #else // defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
 
@@ -690,6 +1546,7 @@ split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
     TRANSACTIONS_OLED_REGISTRATIONS
     TRANSACTIONS_ST7565_REGISTRATIONS
     TRANSACTIONS_POINTING_REGISTRATIONS
+    TRANSACTIONS_BATCH_REGISTRATIONS
 // clang-format on
 
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
@@ -697,13 +1554,18 @@ split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
     [PUT_RPC_REQ_DATA]  = trans_initiator2target_initializer(rpc_m2s_buffer),
     [EXECUTE_RPC]       = trans_initiator2target_initializer_cb(rpc_info.transaction_id, slave_rpc_exec_callback),
     [GET_RPC_RESP_DATA] = trans_target2initiator_initializer(rpc_s2m_buffer),
+#    ifdef SPLIT_RPC_QUEUE_ENABLE
+    [PUT_RPC_QUEUE_INFO]   = trans_initiator2target_initializer_cb(rpc_queue_info, slave_rpc_queue_info_callback),
+    [PUT_RPC_QUEUE_DATA]   = trans_initiator2target_initializer(rpc_queue_m2s_buffer),
+    [GET_RPC_QUEUE_RESULT] = trans_target2initiator_initializer_cb(rpc_queue_s2m_buffer, slave_rpc_queue_exec_callback),
+#    endif // SPLIT_RPC_QUEUE_ENABLE
 #endif // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
 };
 
-bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
-    TRANSACTIONS_SLAVE_MATRIX_MASTER();
+#ifdef SPLIT_TRANSACTION_BATCH
+
+static bool transactions_master_stage(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     TRANSACTIONS_MASTER_MATRIX_MASTER();
-    TRANSACTIONS_ENCODERS_MASTER();
     TRANSACTIONS_SYNC_TIMER_MASTER();
     TRANSACTIONS_LAYER_STATE_MASTER();
     TRANSACTIONS_LED_STATE_MASTER();
@@ -715,10 +1577,103 @@ bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix
     TRANSACTIONS_WPM_MASTER();
     TRANSACTIONS_OLED_MASTER();
     TRANSACTIONS_ST7565_MASTER();
+    return true;
+}
+
+#    ifdef SPLIT_TRANSACTION_ASYNC
+
+bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    bool okay       = true;
+    batch_delivered = 0;
+    batch_waiting   = false;
+    if (batch_in_flight) {
+        split_batch_s2m_t response;
+        bool              success = false;
+        if (transport_transaction_complete(BATCH_EXCHANGE, &success, &response, sizeof(response))) {
+            batch_in_flight = false;
+            okay            = success && batch_unpack_response(&response);
+        } else {
+            batch_waiting = true;
+        }
+    }
+
+    if (okay) {
+        TRANSACTIONS_SLAVE_MATRIX_MASTER();
+        TRANSACTIONS_ENCODERS_MASTER();
+        TRANSACTIONS_POINTING_MASTER();
+    }
+
+    // Put the next frame on the wire, it completes while the rest of the scan runs
+    if (!batch_in_flight) {
+        batch_begin();
+        bool staged   = transactions_master_stage(master_matrix, slave_matrix);
+        batch_staging = false;
+        if (staged) {
+            batch_in_flight = transport_begin_transaction(BATCH_EXCHANGE, &batch_m2s, sizeof(batch_m2s));
+        }
+    }
+    TRANSACTIONS_RPC_QUEUE_MASTER();
+    return okay;
+}
+
+#    else // SPLIT_TRANSACTION_ASYNC
+
+bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    // Collect every outbound region into one frame, exchange it, then consume the slave state it returned
+    batch_begin();
+    bool okay     = transactions_master_stage(master_matrix, slave_matrix);
+    batch_staging = false;
+    if (!okay) return false;
+
+    TRANSACTION_HANDLER_MASTER(batch);
+    TRANSACTIONS_SLAVE_MATRIX_MASTER();
+    TRANSACTIONS_ENCODERS_MASTER();
+    TRANSACTIONS_POINTING_MASTER();
+    TRANSACTIONS_RPC_QUEUE_MASTER();
+    return true;
+}
+
+#    endif // SPLIT_TRANSACTION_ASYNC
+
+#else // SPLIT_TRANSACTION_BATCH
+
+// Input first, then state, with cosmetic data last
+static bool transactions_master_cycle(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+#    ifdef SPLIT_SLAVE_EVENTS_ENABLE
+    slave_events_due = slave_events_signalled();
+#    endif // SPLIT_SLAVE_EVENTS_ENABLE
+    TRANSACTIONS_SLAVE_MATRIX_MASTER();
+    TRANSACTIONS_ENCODERS_MASTER();
     TRANSACTIONS_POINTING_MASTER();
+    TRANSACTIONS_SCHEDULED(STATE, MASTER_MATRIX);
+    TRANSACTIONS_SCHEDULED(STATE, SYNC_TIMER);
+    TRANSACTIONS_SCHEDULED(STATE, LAYER_STATE);
+    TRANSACTIONS_SCHEDULED(STATE, LED_STATE);
+    TRANSACTIONS_SCHEDULED(STATE, MODS);
+    TRANSACTIONS_SCHEDULED(COSMETIC, BACKLIGHT);
+    TRANSACTIONS_SCHEDULED(COSMETIC, RGBLIGHT);
+    TRANSACTIONS_SCHEDULED(COSMETIC, LED_MATRIX);
+    TRANSACTIONS_SCHEDULED(COSMETIC, RGB_MATRIX);
+    TRANSACTIONS_SCHEDULED(COSMETIC, WPM);
+    TRANSACTIONS_SCHEDULED(COSMETIC, OLED);
+    TRANSACTIONS_SCHEDULED(COSMETIC, ST7565);
+    TRANSACTIONS_RPC_QUEUE_MASTER();
     return true;
 }
 
+bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+#    ifdef SPLIT_SYNC_SCHEDULER_ENABLE
+    sync_cycle_begin();
+    bool okay = transactions_master_cycle(master_matrix, slave_matrix);
+    sync_cycle_end();
+    return okay;
+#    else
+    return transactions_master_cycle(master_matrix, slave_matrix);
+#    endif // SPLIT_SYNC_SCHEDULER_ENABLE
+}
+
+#endif // SPLIT_TRANSACTION_BATCH
+
 void transactions_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     TRANSACTIONS_SLAVE_MATRIX_SLAVE();
     TRANSACTIONS_MASTER_MATRIX_SLAVE();
@@ -808,4 +1763,144 @@ void slave_rpc_exec_callback(uint8_t initiator2target_buffer_size, const void *i
     }
 }
 
+#    ifdef SPLIT_RPC_QUEUE_ENABLE
+
+static uint8_t              rpc_queue_m2s[SPLIT_RPC_QUEUE_M2S_SIZE];
+static uint8_t              rpc_queue_s2m[SPLIT_RPC_QUEUE_S2M_SIZE];
+static split_rpc_callback_t rpc_queue_callbacks[SPLIT_RPC_QUEUE_LENGTH];
+static uint8_t              rpc_queue_count    = 0;
+static uint8_t              rpc_queue_m2s_used = 0;
+static uint8_t              rpc_queue_s2m_used = 0;
+static uint8_t              rpc_queue_sequence = 0;
+static bool                 rpc_queue_restart  = true; // until a frame told the slave that the sequence started over
+
+// Slave side, the sequence of the frame executed last
+static bool    rpc_queue_executed      = false;
+static uint8_t rpc_queue_last_sequence = 0;
+
+void transaction_rpc_queue_restart(void) {
+    rpc_queue_sequence = 0;
+    rpc_queue_restart  = true;
+}
+
+bool transaction_rpc_queue(int8_t transaction_id, uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, split_rpc_callback_t callback) {
+    // Prevent queueing while transport is disconnected
+    if (!is_transport_connected()) {
+        return false;
+    }
+    // Prevent invoking RPC on QMK core sync data
+    if (transaction_id <= GET_RPC_RESP_DATA) return false;
+    // Prevent overflowing this cycle's frame, the caller can try again after the next sync
+    if (rpc_queue_count >= SPLIT_RPC_QUEUE_LENGTH) return false;
+    if (rpc_queue_m2s_used + sizeof(rpc_sync_info_t) + initiator2target_buffer_size > sizeof(rpc_queue_m2s)) return false;
+    if (rpc_queue_s2m_used + target2initiator_buffer_size > sizeof(rpc_queue_s2m)) return false;
+
+    rpc_sync_info_t info = {.transaction_id = transaction_id, .m2s_length = initiator2target_buffer_size, .s2m_length = target2initiator_buffer_size};
+    memcpy(&rpc_queue_m2s[rpc_queue_m2s_used], &info, sizeof(info));
+    memcpy(&rpc_queue_m2s[rpc_queue_m2s_used + sizeof(info)], initiator2target_buffer, initiator2target_buffer_size);
+    rpc_queue_m2s_used += sizeof(info) + initiator2target_buffer_size;
+    rpc_queue_s2m_used += target2initiator_buffer_size;
+    rpc_queue_callbacks[rpc_queue_count++] = callback;
+    return true;
+}
+
+static bool rpc_queue_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    rpc_queue_info_t info = {.sequence = rpc_queue_sequence, .m2s_length = rpc_queue_m2s_used, .s2m_length = rpc_queue_s2m_used, .restart = rpc_queue_restart};
+
+    // Make sure the local side knows how much of the frame is in use
+    split_transaction_table[PUT_RPC_QUEUE_DATA].initiator2target_buffer_size   = info.m2s_length;
+    split_transaction_table[GET_RPC_QUEUE_RESULT].target2initiator_buffer_size = info.s2m_length;
+
+    // Three transfers regardless of how many requests are queued:
+    // * set the sequence number and frame lengths
+    // * send the packed requests
+    // * execute them all, and retrieve the packed responses
+    if (!transport_write(PUT_RPC_QUEUE_INFO, &info, sizeof(info))) {
+        return false;
+    }
+    // Once the slave has seen it, a retry of this frame has to be recognised as a repeat again
+    rpc_queue_restart = false;
+    if (!transport_write(PUT_RPC_QUEUE_DATA, rpc_queue_m2s, info.m2s_length)) {
+        return false;
+    }
+    if (!transport_read(GET_RPC_QUEUE_RESULT, rpc_queue_s2m, info.s2m_length)) {
+        return false;
+    }
+    return true;
+}
+
+static void rpc_queue_flush(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    if (rpc_queue_count == 0) {
+        return;
+    }
+
+    // A frame is only attempted once, so that a later frame can't be mistaken for a repeat of a failed one
+    bool okay = transaction_handler_master(master_matrix, slave_matrix, "rpc_queue", &rpc_queue_handlers_master);
+    rpc_queue_sequence++;
+
+    uint8_t m2s_used = 0;
+    uint8_t s2m_used = 0;
+    for (uint8_t i = 0; i < rpc_queue_count; ++i) {
+        rpc_sync_info_t info;
+        memcpy(&info, &rpc_queue_m2s[m2s_used], sizeof(info));
+        if (rpc_queue_callbacks[i]) {
+            rpc_queue_callbacks[i](info.transaction_id, okay, info.s2m_length, &rpc_queue_s2m[s2m_used]);
+        }
+        m2s_used += sizeof(info) + info.m2s_length;
+        s2m_used += info.s2m_length;
+    }
+    rpc_queue_count    = 0;
+    rpc_queue_m2s_used = 0;
+    rpc_queue_s2m_used = 0;
+}
+
+void slave_rpc_queue_info_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
+    // As with the regular RPC info block, size the following transfers to match what the master is sending
+    uint8_t m2s_length = split_shmem->rpc_queue_info.m2s_length;
+    uint8_t s2m_length = split_shmem->rpc_queue_info.s2m_length;
+
+    split_transaction_table[PUT_RPC_QUEUE_DATA].initiator2target_buffer_size   = m2s_length < SPLIT_RPC_QUEUE_M2S_SIZE ? m2s_length : SPLIT_RPC_QUEUE_M2S_SIZE;
+    split_transaction_table[GET_RPC_QUEUE_RESULT].target2initiator_buffer_size = s2m_length < SPLIT_RPC_QUEUE_S2M_SIZE ? s2m_length : SPLIT_RPC_QUEUE_S2M_SIZE;
+
+    // A rebooted master counts from 0 again, its frames must not be taken for repeats of older ones
+    if (split_shmem->rpc_queue_info.restart) {
+        rpc_queue_executed = false;
+    }
+}
+
+void slave_rpc_queue_exec_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
+    // The master retries a frame whose response got lost, the responses from the first attempt are still in place
+    if (rpc_queue_executed && split_shmem->rpc_queue_info.sequence == rpc_queue_last_sequence) {
+        return;
+    }
+    rpc_queue_executed      = true;
+    rpc_queue_last_sequence = split_shmem->rpc_queue_info.sequence;
+
+    // Unpack each request in turn, and execute _that_ transaction's callback with its slice of the response frame
+    uint8_t m2s_length = split_transaction_table[PUT_RPC_QUEUE_DATA].initiator2target_buffer_size;
+    uint8_t s2m_length = split_transaction_table[GET_RPC_QUEUE_RESULT].target2initiator_buffer_size;
+    uint8_t m2s_used   = 0;
+    uint8_t s2m_used   = 0;
+    while (m2s_used + sizeof(rpc_sync_info_t) <= m2s_length) {
+        rpc_sync_info_t info;
+        memcpy(&info, &split_shmem->rpc_queue_m2s_buffer[m2s_used], sizeof(info));
+        m2s_used += sizeof(info);
+        if (m2s_used + info.m2s_length > m2s_length || s2m_used + info.s2m_length > s2m_length) {
+            break;
+        }
+        uint8_t *response = &split_shmem->rpc_queue_s2m_buffer[s2m_used];
+        memset(response, 0, info.s2m_length);
+        if (info.transaction_id > GET_RPC_RESP_DATA && info.transaction_id < NUM_TOTAL_TRANSACTIONS) {
+            split_transaction_desc_t *trans = &split_transaction_table[info.transaction_id];
+            if (trans->slave_callback) {
+                trans->slave_callback(info.m2s_length, &split_shmem->rpc_queue_m2s_buffer[m2s_used], info.s2m_length, response);
+            }
+        }
+        m2s_used += info.m2s_length;
+        s2m_used += info.s2m_length;
+    }
+}
+
+#    endif // SPLIT_RPC_QUEUE_ENABLE
+
 #endif // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
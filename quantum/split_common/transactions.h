@@ -51,3 +51,29 @@ bool transaction_rpc_exec(int8_t transaction_id, uint8_t initiator2target_buffer
 
 #define transaction_rpc_send(transaction_id, initiator2target_buffer_size, initiator2target_buffer) transaction_rpc_exec(transaction_id, initiator2target_buffer_size, initiator2target_buffer, 0, NULL)
 #define transaction_rpc_recv(transaction_id, target2initiator_buffer_size, target2initiator_buffer) transaction_rpc_exec(transaction_id, 0, NULL, target2initiator_buffer_size, target2initiator_buffer)
+
+#ifdef SPLIT_RPC_QUEUE_ENABLE
+// Invoked on the master once a queued request has been executed on the slave, or has failed
+typedef void (*split_rpc_callback_t)(int8_t transaction_id, bool success, uint8_t target2initiator_buffer_size, const void *target2initiator_buffer);
+
+// Queues the request to go out with the next sync cycle, returns false if it does not fit
+bool transaction_rpc_queue(int8_t transaction_id, uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, split_rpc_callback_t callback);
+
+// Starts the frame sequence over as after a reboot, for when the link was re-established
+void transaction_rpc_queue_restart(void);
+
+#    define transaction_rpc_queue_send(transaction_id, initiator2target_buffer_size, initiator2target_buffer, callback) transaction_rpc_queue(transaction_id, initiator2target_buffer_size, initiator2target_buffer, 0, callback)
+#    define transaction_rpc_queue_recv(transaction_id, target2initiator_buffer_size, callback) transaction_rpc_queue(transaction_id, 0, NULL, target2initiator_buffer_size, callback)
+#endif // SPLIT_RPC_QUEUE_ENABLE
+
+#ifdef SPLIT_SYNC_SCHEDULER_ENABLE
+typedef struct split_sync_stats_t {
+    uint16_t bytes_per_ms; // measured throughput of the link
+    uint16_t budget_bytes; // bytes a cycle may use at that throughput, SPLIT_SYNC_BUDGET_US worth
+    uint16_t cycle_bytes;  // bytes used by the last cycle
+    uint32_t deferred;     // handlers held back by the budget or their maximum rate
+    uint32_t forced;       // handlers run over budget as they reached their minimum rate
+} split_sync_stats_t;
+
+const split_sync_stats_t *split_sync_get_stats(void);
+#endif // SPLIT_SYNC_SCHEDULER_ENABLE
@@ -119,6 +119,40 @@ bool transport_execute_transaction(int8_t id, const void *initiator2target_buf,
     return true;
 }
 
+#    ifdef SPLIT_TRANSACTION_ASYNC
+#        ifndef SERIAL_DRIVER_USART
+#            error "SPLIT_TRANSACTION_ASYNC requires SERIAL_DRIVER = usart"
+#        endif
+
+bool transport_begin_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length) {
+    split_transaction_desc_t *trans = &split_transaction_table[id];
+    if (initiator2target_length > 0) {
+        size_t len = trans->initiator2target_buffer_size < initiator2target_length ? trans->initiator2target_buffer_size : initiator2target_length;
+        memcpy(split_trans_initiator2target_buffer(trans), initiator2target_buf, len);
+    }
+
+    return soft_serial_transaction_begin(id);
+}
+
+bool transport_transaction_complete(int8_t id, bool *success, void *target2initiator_buf, uint16_t target2initiator_length) {
+    if (!soft_serial_transaction_complete(success)) {
+        return false;
+    }
+
+    split_transaction_desc_t *trans = &split_transaction_table[id];
+    if (*success && target2initiator_length > 0) {
+        size_t len = trans->target2initiator_buffer_size < target2initiator_length ? trans->target2initiator_buffer_size : target2initiator_length;
+        memcpy(target2initiator_buf, split_trans_target2initiator_buffer(trans), len);
+    }
+
+    return true;
+}
+
+void transport_transaction_wait(void) {
+    soft_serial_transaction_wait();
+}
+#    endif // SPLIT_TRANSACTION_ASYNC
+
 #endif // USE_I2C
 
 bool transport_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
@@ -31,6 +31,33 @@
 #    define RPC_S2M_BUFFER_SIZE 32
 #endif // RPC_S2M_BUFFER_SIZE
 
+#ifdef SPLIT_RPC_QUEUE_ENABLE
+#    ifndef SPLIT_RPC_QUEUE_LENGTH
+#        define SPLIT_RPC_QUEUE_LENGTH 4
+#    endif // SPLIT_RPC_QUEUE_LENGTH
+#    ifndef SPLIT_RPC_QUEUE_M2S_SIZE
+#        define SPLIT_RPC_QUEUE_M2S_SIZE 48
+#    endif // SPLIT_RPC_QUEUE_M2S_SIZE
+#    ifndef SPLIT_RPC_QUEUE_S2M_SIZE
+#        define SPLIT_RPC_QUEUE_S2M_SIZE 32
+#    endif // SPLIT_RPC_QUEUE_S2M_SIZE
+#endif // SPLIT_RPC_QUEUE_ENABLE
+
+#ifdef SPLIT_SLAVE_EVENTS_ENABLE
+#    ifndef SPLIT_SLAVE_EVENT_BUFFER_SIZE
+#        define SPLIT_SLAVE_EVENT_BUFFER_SIZE 8
+#    endif // SPLIT_SLAVE_EVENT_BUFFER_SIZE
+#    ifndef SPLIT_SLAVE_EVENT_HEARTBEAT_MS
+#        define SPLIT_SLAVE_EVENT_HEARTBEAT_MS 50
+#    endif // SPLIT_SLAVE_EVENT_HEARTBEAT_MS
+#endif // SPLIT_SLAVE_EVENTS_ENABLE
+
+#ifdef SPLIT_TRANSACTION_BATCH
+#    ifndef SPLIT_BATCH_BUFFER_SIZE
+#        define SPLIT_BATCH_BUFFER_SIZE 32
+#    endif // SPLIT_BATCH_BUFFER_SIZE
+#endif // SPLIT_TRANSACTION_BATCH
+
 void transport_master_init(void);
 void transport_slave_init(void);
 
@@ -40,6 +67,15 @@ void transport_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]);
 
 bool transport_execute_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length);
 
+#ifdef SPLIT_TRANSACTION_ASYNC
+// returns false if the transaction could not be started
+bool transport_begin_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length);
+// returns false while the transaction is still in progress
+bool transport_transaction_complete(int8_t id, bool *success, void *target2initiator_buf, uint16_t target2initiator_length);
+// blocks until the transaction in progress, if any, has finished, so the line is free for transport_execute_transaction
+void transport_transaction_wait(void);
+#endif // SPLIT_TRANSACTION_ASYNC
+
 #ifdef ENCODER_ENABLE
 #    include "encoder.h"
 #    define NUMBER_OF_ENCODERS (sizeof((pin_t[])ENCODERS_PAD_A) / sizeof(pin_t))
@@ -58,6 +94,22 @@ typedef struct _split_slave_matrix_sync_t {
     matrix_row_t matrix[(MATRIX_ROWS) / 2];
 } split_slave_matrix_sync_t;
 
+#ifdef SPLIT_SLAVE_EVENTS_ENABLE
+#    define SPLIT_KEY_EDGE_PRESSED 0x80
+#    define SPLIT_SLAVE_EVENTS_OVERFLOW 0xFF
+
+typedef struct _split_key_edge_t {
+    uint8_t row;
+    uint8_t col; // SPLIT_KEY_EDGE_PRESSED is set for key down
+} split_key_edge_t;
+
+typedef struct _split_slave_events_sync_t {
+    uint8_t          checksum; // crc8 over count and the edges that follow it
+    uint8_t          count;    // SPLIT_SLAVE_EVENTS_OVERFLOW if edges were dropped
+    split_key_edge_t edges[SPLIT_SLAVE_EVENT_BUFFER_SIZE];
+} split_slave_events_sync_t;
+#endif // SPLIT_SLAVE_EVENTS_ENABLE
+
 #ifdef SPLIT_TRANSPORT_MIRROR
 typedef struct _split_master_matrix_sync_t {
     matrix_row_t matrix[(MATRIX_ROWS) / 2];
@@ -106,12 +158,56 @@ typedef struct _split_mods_sync_t {
 } split_mods_sync_t;
 #endif // SPLIT_MODS_ENABLE
 
+#if defined(SPLIT_OLED_MIRROR_ENABLE) || defined(SPLIT_ST7565_MIRROR_ENABLE)
+// A frame of changed display blocks, each one as its index followed by its run-length encoded contents
+typedef struct _split_display_mirror_header_t {
+    uint8_t checksum;
+    uint8_t sequence;
+    uint8_t length;
+} split_display_mirror_header_t;
+#endif // defined(SPLIT_OLED_MIRROR_ENABLE) || defined(SPLIT_ST7565_MIRROR_ENABLE)
+
+#if defined(OLED_ENABLE) && defined(SPLIT_OLED_ENABLE) && defined(SPLIT_OLED_MIRROR_ENABLE)
+#    include "oled_driver.h"
+#    ifndef SPLIT_OLED_MIRROR_BUDGET
+#        define SPLIT_OLED_MIRROR_BUDGET (OLED_BLOCK_SIZE + OLED_BLOCK_SIZE / 2)
+#    endif // SPLIT_OLED_MIRROR_BUDGET
+typedef struct _split_oled_mirror_t {
+    split_display_mirror_header_t header;
+    uint8_t                       data[SPLIT_OLED_MIRROR_BUDGET];
+} split_oled_mirror_t;
+#endif // defined(OLED_ENABLE) && defined(SPLIT_OLED_ENABLE) && defined(SPLIT_OLED_MIRROR_ENABLE)
+
+#if defined(ST7565_ENABLE) && defined(SPLIT_ST7565_ENABLE) && defined(SPLIT_ST7565_MIRROR_ENABLE)
+#    include "st7565.h"
+#    ifndef SPLIT_ST7565_MIRROR_BUDGET
+#        define SPLIT_ST7565_MIRROR_BUDGET (ST7565_BLOCK_SIZE + ST7565_BLOCK_SIZE / 2)
+#    endif // SPLIT_ST7565_MIRROR_BUDGET
+typedef struct _split_st7565_mirror_t {
+    split_display_mirror_header_t header;
+    uint8_t                       data[SPLIT_ST7565_MIRROR_BUDGET];
+} split_st7565_mirror_t;
+#endif // defined(ST7565_ENABLE) && defined(SPLIT_ST7565_ENABLE) && defined(SPLIT_ST7565_MIRROR_ENABLE)
+
 #if defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
 #    include "pointing_device.h"
+// Running totals of the slave's sensor motion, wrapping at 16 bits. The master takes the
+// difference from the last totals it saw, so reads can be repeated or missed without losing counts.
+// The epoch echoes the one set by the master, it is zero after the slave boots and the totals restart.
+typedef struct _split_pointing_motion_t {
+    uint8_t  checksum;
+    uint8_t  buttons;
+    uint8_t  epoch;
+    uint16_t x;
+    uint16_t y;
+    uint16_t v;
+    uint16_t h;
+} split_pointing_motion_t;
+
 typedef struct _split_slave_pointing_sync_t {
-    uint8_t        checksum;
-    report_mouse_t report;
-    uint16_t       cpi;
+    split_pointing_motion_t motion;
+    uint16_t                cpi;
+    uint8_t                 epoch;
 } split_slave_pointing_sync_t;
 #endif // defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
 
@@ -121,8 +217,33 @@ typedef struct _rpc_sync_info_t {
     uint8_t m2s_length;
     uint8_t s2m_length;
 } rpc_sync_info_t;
+
+#    ifdef SPLIT_RPC_QUEUE_ENABLE
+// Each queued request is packed as an rpc_sync_info_t followed by its request data
+typedef struct _rpc_queue_info_t {
+    uint8_t sequence; // lets the slave spot a repeated frame, and answer it without executing again
+    uint8_t m2s_length;
+    uint8_t s2m_length;
+    bool    restart; // the master started over, the slave forgets the last sequence it executed
+} rpc_queue_info_t;
+#    endif // SPLIT_RPC_QUEUE_ENABLE
 #endif // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
 
+#ifdef SPLIT_TRANSACTION_BATCH
+// Regions are identified by transaction ID, and packed into the payload in ascending ID order
+typedef struct _split_batch_m2s_t {
+    uint32_t put_mask;
+    uint32_t get_mask;
+    uint8_t  payload[SPLIT_BATCH_BUFFER_SIZE];
+} split_batch_m2s_t;
+
+typedef struct _split_batch_s2m_t {
+    uint32_t mask;
+    uint8_t  payload[SPLIT_BATCH_BUFFER_SIZE];
+    uint8_t  checksum;
+} split_batch_s2m_t;
+#endif // SPLIT_TRANSACTION_BATCH
+
 typedef struct _split_shared_memory_t {
 #ifdef USE_I2C
     int8_t transaction_id;
@@ -130,6 +251,10 @@ typedef struct _split_shared_memory_t {
 
     split_slave_matrix_sync_t smatrix;
 
+#ifdef SPLIT_SLAVE_EVENTS_ENABLE
+    split_slave_events_sync_t events;
+#endif // SPLIT_SLAVE_EVENTS_ENABLE
+
 #ifdef SPLIT_TRANSPORT_MIRROR
     split_master_matrix_sync_t mmatrix;
 #endif // SPLIT_TRANSPORT_MIRROR
@@ -168,6 +293,9 @@ typedef struct _split_shared_memory_t {
 
 #if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
     rgb_matrix_sync_t rgb_matrix_sync;
+#    ifdef RGB_MATRIX_SPLIT_LOCKSTEP
+    rgb_matrix_lockstep_t rgb_matrix_lockstep;
+#    endif // RGB_MATRIX_SPLIT_LOCKSTEP
 #endif // defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
 
 #if defined(WPM_ENABLE) && defined(SPLIT_WPM_ENABLE)
@@ -176,20 +304,38 @@ typedef struct _split_shared_memory_t {
 
 #if defined(OLED_ENABLE) && defined(SPLIT_OLED_ENABLE)
     uint8_t current_oled_state;
-#endif // defined(OLED_ENABLE) && defined(SPLIT_OLED_ENABLE)
+#    ifdef SPLIT_OLED_MIRROR_ENABLE
+    uint8_t             oled_mirror_length;
+    split_oled_mirror_t oled_mirror;
+#    endif // SPLIT_OLED_MIRROR_ENABLE
+#endif     // defined(OLED_ENABLE) && defined(SPLIT_OLED_ENABLE)
 
 #if defined(ST7565_ENABLE) && defined(SPLIT_ST7565_ENABLE)
     uint8_t current_st7565_state;
-#endif // ST7565_ENABLE(OLED_ENABLE) && defined(SPLIT_ST7565_ENABLE)
+#    ifdef SPLIT_ST7565_MIRROR_ENABLE
+    uint8_t               st7565_mirror_length;
+    split_st7565_mirror_t st7565_mirror;
+#    endif // SPLIT_ST7565_MIRROR_ENABLE
+#endif     // ST7565_ENABLE(OLED_ENABLE) && defined(SPLIT_ST7565_ENABLE)
 
 #if defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
     split_slave_pointing_sync_t pointing;
 #endif // defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
 
+#ifdef SPLIT_TRANSACTION_BATCH
+    split_batch_m2s_t batch_m2s;
+    split_batch_s2m_t batch_s2m;
+#endif // SPLIT_TRANSACTION_BATCH
+
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
     rpc_sync_info_t rpc_info;
     uint8_t         rpc_m2s_buffer[RPC_M2S_BUFFER_SIZE];
     uint8_t         rpc_s2m_buffer[RPC_S2M_BUFFER_SIZE];
+#    ifdef SPLIT_RPC_QUEUE_ENABLE
+    rpc_queue_info_t rpc_queue_info;
+    uint8_t          rpc_queue_m2s_buffer[SPLIT_RPC_QUEUE_M2S_SIZE];
+    uint8_t          rpc_queue_s2m_buffer[SPLIT_RPC_QUEUE_S2M_SIZE];
+#    endif // SPLIT_RPC_QUEUE_ENABLE
 #endif // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
 } split_shared_memory_t;
 
@@ -64,21 +64,22 @@ TEST_F(KeyPress, CorrectKeysAreReportedWhenTwoKeysArePressed) {
 
     key_b.press();
     key_c.press();
-    // Note that QMK only processes one key at a time
-    // See issue #1476 for more information
-    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(key_b.report_code)));
-    keyboard_task();
-
-    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(key_b.report_code, key_c.report_code)));
+    // Note that all keys changed in one scan are processed in matrix order
+    {
+        InSequence s;
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(key_b.report_code)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(key_b.report_code, key_c.report_code)));
+    }
     keyboard_task();
 
     key_b.release();
     key_c.release();
     // Note that the first key released is the first one in the matrix order
-    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(key_c.report_code)));
-    keyboard_task();
-
-    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    {
+        InSequence s;
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(key_c.report_code)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    }
     keyboard_task();
 }
 
@@ -94,9 +95,11 @@ TEST_F(KeyPress, LeftShiftIsReportedCorrectly) {
 
     // Unfortunately modifiers are also processed in the wrong order
     // See issue #1476 for more information
-    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(key_a.report_code)));
-    keyboard_task();
-    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(key_a.report_code, key_lsft.report_code)));
+    {
+        InSequence s;
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(key_a.report_code)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(key_a.report_code, key_lsft.report_code)));
+    }
     keyboard_task();
 
     key_a.release();
@@ -120,19 +123,21 @@ TEST_F(KeyPress, PressLeftShiftAndControl) {
 
     // Unfortunately modifiers are also processed in the wrong order
     // See issue #1476 for more information
-    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(key_lsft.report_code)));
-    keyboard_task();
-
-    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(key_lsft.report_code, key_lctrl.report_code)));
+    {
+        InSequence s;
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(key_lsft.report_code)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(key_lsft.report_code, key_lctrl.report_code)));
+    }
     keyboard_task();
 
     key_lsft.release();
     key_lctrl.release();
 
-    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(key_lctrl.report_code)));
-    keyboard_task();
-
-    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    {
+        InSequence s;
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(key_lctrl.report_code)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    }
     keyboard_task();
 }
 
@@ -147,18 +152,54 @@ TEST_F(KeyPress, LeftAndRightShiftCanBePressedAtTheSameTime) {
     key_rsft.press();
     // Unfortunately modifiers are also processed in the wrong order
     // See issue #1476 for more information
-    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(key_lsft.report_code)));
-    keyboard_task();
-
-    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(key_lsft.report_code, key_rsft.report_code)));
+    {
+        InSequence s;
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(key_lsft.report_code)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(key_lsft.report_code, key_rsft.report_code)));
+    }
     keyboard_task();
 
     key_lsft.release();
     key_rsft.release();
 
-    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(key_rsft.report_code)));
+    {
+        InSequence s;
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(key_rsft.report_code)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    }
     keyboard_task();
+}
+
+TEST_F(KeyPress, AllKeysChangedInOneScanAreProcessedInOnePass) {
+    TestDriver driver;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+    auto       key_s = KeymapKey(0, 1, 0, KC_S);
+    auto       key_d = KeymapKey(0, 2, 0, KC_D);
+    auto       key_j = KeymapKey(0, 0, 1, KC_J);
+    auto       key_k = KeymapKey(0, 1, 1, KC_K);
+    auto       key_l = KeymapKey(0, 2, 1, KC_L);
+
+    set_keymap({key_a, key_s, key_d, key_j, key_k, key_l});
+
+    for (auto key : {key_a, key_s, key_d, key_j, key_k, key_l}) {
+        key.press();
+    }
+    {
+        InSequence s;
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_A)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_A, KC_S)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_A, KC_S, KC_D)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_A, KC_S, KC_D, KC_J)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_A, KC_S, KC_D, KC_J, KC_K)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_A, KC_S, KC_D, KC_J, KC_K, KC_L)));
+    }
+    keyboard_task();
+    testing::Mock::VerifyAndClearExpectations(&driver);
 
+    for (auto key : {key_a, key_s, key_d, key_j, key_k, key_l}) {
+        key.release();
+    }
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(5);
     EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
     keyboard_task();
 }
@@ -0,0 +1,76 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "bench_fixture.hpp"
+
+class Basic : public BenchFixture {};
+
+TEST_F(Basic, Idle) {
+    set_bench_keymap(1, {});
+
+    auto result = replay("idle", {});
+    EXPECT_EQ(result.allocations, 0);
+    EXPECT_EQ(result.reports, 0);
+}
+
+TEST_F(Basic, Rollover) {
+    auto key_q = KeymapKey(0, 0, 0, KC_Q);
+    auto key_w = KeymapKey(0, 1, 0, KC_W);
+    auto key_e = KeymapKey(0, 2, 0, KC_E);
+    auto key_r = KeymapKey(0, 3, 0, KC_R);
+    auto key_t = KeymapKey(0, 4, 0, KC_T);
+    auto key_y = KeymapKey(0, 5, 0, KC_Y);
+    Trace pattern;
+
+    set_bench_keymap(1, {key_q, key_w, key_e, key_r, key_t, key_y});
+    trace_roll(pattern, 0, {key_q, key_w, key_e, key_r, key_t, key_y}, 5, 40);
+
+    auto result = replay("rollover", trace_repeat(pattern, 20, 100));
+    EXPECT_EQ(result.allocations, 0);
+    EXPECT_EQ(result.reports, 20 * 12);
+}
+
+TEST_F(Basic, FullMatrixChord) {
+    Trace pattern;
+
+    set_bench_keymap(1, {});
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            trace_tap(pattern, 0, KeymapKey(0, col, row, KC_NO), 50);
+        }
+    }
+
+    auto result = replay("full matrix chord", trace_repeat(pattern, 20, 100));
+    EXPECT_EQ(result.allocations, 0);
+}
+
+TEST_F(Basic, ModTapStorm) {
+    auto key_a = KeymapKey(0, 0, 1, LGUI_T(KC_A));
+    auto key_s = KeymapKey(0, 1, 1, LALT_T(KC_S));
+    auto key_d = KeymapKey(0, 2, 1, LCTL_T(KC_D));
+    auto key_f = KeymapKey(0, 3, 1, LSFT_T(KC_F));
+    auto key_j = KeymapKey(0, 6, 1, KC_J);
+    Trace pattern;
+
+    set_bench_keymap(1, {key_a, key_s, key_d, key_f, key_j});
+    /* Home row mods rolled faster than the tapping term, followed by a held shift. */
+    trace_roll(pattern, 0, {key_a, key_s, key_d, key_f}, 30, 60);
+    trace_tap(pattern, 200, key_f, TAPPING_TERM + 50);
+    trace_tap(pattern, 200 + TAPPING_TERM + 10, key_j, 20);
+
+    auto result = replay("mod-tap storm", trace_repeat(pattern, 10, 600));
+    EXPECT_EQ(result.allocations, 0);
+}
@@ -0,0 +1,84 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "bench_fixture.hpp"
+
+extern "C" {
+#include "process_combo.h"
+
+const uint16_t PROGMEM qw_combo[]  = {KC_Q, KC_W, COMBO_END};
+const uint16_t PROGMEM we_combo[]  = {KC_W, KC_E, COMBO_END};
+const uint16_t PROGMEM er_combo[]  = {KC_E, KC_R, COMBO_END};
+const uint16_t PROGMEM qwe_combo[] = {KC_Q, KC_W, KC_E, COMBO_END};
+const uint16_t PROGMEM as_combo[]  = {KC_A, KC_S, COMBO_END};
+const uint16_t PROGMEM sd_combo[]  = {KC_S, KC_D, COMBO_END};
+const uint16_t PROGMEM df_combo[]  = {KC_D, KC_F, COMBO_END};
+const uint16_t PROGMEM jk_combo[]  = {KC_J, KC_K, COMBO_END};
+
+combo_t key_combos[COMBO_COUNT] = {
+    COMBO(qw_combo, KC_ESC), COMBO(we_combo, KC_TAB), COMBO(er_combo, KC_BSPC), COMBO(qwe_combo, KC_ENT), COMBO(as_combo, KC_LGUI), COMBO(sd_combo, KC_LALT), COMBO(df_combo, KC_LCTL), COMBO(jk_combo, KC_ESC),
+};
+}
+
+class Combo : public BenchFixture {
+   protected:
+    KeymapKey key_q = KeymapKey(0, 0, 0, KC_Q);
+    KeymapKey key_w = KeymapKey(0, 1, 0, KC_W);
+    KeymapKey key_e = KeymapKey(0, 2, 0, KC_E);
+    KeymapKey key_r = KeymapKey(0, 3, 0, KC_R);
+    KeymapKey key_a = KeymapKey(0, 0, 1, KC_A);
+    KeymapKey key_s = KeymapKey(0, 1, 1, KC_S);
+    KeymapKey key_d = KeymapKey(0, 2, 1, KC_D);
+    KeymapKey key_f = KeymapKey(0, 3, 1, KC_F);
+    KeymapKey key_j = KeymapKey(0, 6, 1, KC_J);
+    KeymapKey key_k = KeymapKey(0, 7, 1, KC_K);
+
+    void SetUp() override {
+        set_bench_keymap(1, {key_q, key_w, key_e, key_r, key_a, key_s, key_d, key_f, key_j, key_k});
+    }
+};
+
+TEST_F(Combo, Chords) {
+    Trace pattern;
+
+    trace_roll(pattern, 0, {key_q, key_w}, 0, 30);
+    trace_roll(pattern, 100, {key_q, key_w, key_e}, 5, 30);
+    trace_roll(pattern, 200, {key_j, key_k}, 10, 30);
+
+    auto result = replay("combo chords", trace_repeat(pattern, 20, 300));
+    EXPECT_EQ(result.allocations, 0);
+}
+
+TEST_F(Combo, TypingThroughComboKeys) {
+    Trace pattern;
+
+    /* Every key is part of a combo, but none are pressed together long enough to trigger one. */
+    trace_roll(pattern, 0, {key_q, key_a, key_w, key_s, key_e, key_d, key_r, key_f, key_j, key_k}, COMBO_TERM + 10, 20);
+
+    auto result = replay("typing through combo keys", trace_repeat(pattern, 5, 10 * (COMBO_TERM + 10)));
+    EXPECT_EQ(result.allocations, 0);
+    EXPECT_EQ(result.reports, 5 * 10 * 2);
+}
+
+TEST_F(Combo, HeldCombos) {
+    Trace pattern;
+
+    trace_roll(pattern, 0, {key_a, key_s}, 0, TAPPING_TERM + 50);
+    trace_roll(pattern, 20, {key_d, key_f}, 0, 100);
+
+    auto result = replay("held combos", trace_repeat(pattern, 10, 400));
+    EXPECT_EQ(result.allocations, 0);
+}
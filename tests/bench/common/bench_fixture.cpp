@@ -0,0 +1,193 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "bench_fixture.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "host.h"
+#include "keycode.h"
+#include "test_matrix.h"
+
+/* Every heap allocation of the firmware is counted, see the --wrap flags in build_bench.mk. */
+static uint32_t bench_allocations = 0;
+
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t count, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+
+void *__wrap_malloc(size_t size) {
+    bench_allocations++;
+    return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t count, size_t size) {
+    bench_allocations++;
+    return __real_calloc(count, size);
+}
+
+void *__wrap_realloc(void *ptr, size_t size) {
+    bench_allocations++;
+    return __real_realloc(ptr, size);
+}
+}
+
+/* A host driver that only counts reports, so mock bookkeeping doesn't end up in the measurement. */
+static uint32_t bench_reports = 0;
+
+static uint8_t bench_keyboard_leds(void) {
+    return 0;
+}
+
+static void bench_send_keyboard(report_keyboard_t *report) {
+    bench_reports++;
+}
+
+static void bench_send_mouse(report_mouse_t *report) {
+    bench_reports++;
+}
+
+static void bench_send_extra(uint16_t data) {
+    bench_reports++;
+}
+
+static void bench_send_programmable_button(uint32_t data) {
+    bench_reports++;
+}
+
+static host_driver_t bench_driver = {bench_keyboard_leds, bench_send_keyboard, bench_send_mouse, bench_send_extra, bench_send_extra, bench_send_programmable_button};
+
+void trace_tap(Trace &trace, uint32_t time, const KeymapKey &key, uint16_t hold) {
+    trace.push_back({time, key.position.col, key.position.row, true});
+    trace.push_back({time + hold, key.position.col, key.position.row, false});
+}
+
+void trace_roll(Trace &trace, uint32_t time, std::initializer_list<KeymapKey> keys, uint16_t interval, uint16_t hold) {
+    for (auto &key : keys) {
+        trace_tap(trace, time, key, hold);
+        time += interval;
+    }
+}
+
+Trace trace_repeat(const Trace &pattern, unsigned count, uint32_t period) {
+    Trace trace;
+    for (unsigned i = 0; i < count; i++) {
+        for (auto event : pattern) {
+            event.time += i * period;
+            trace.push_back(event);
+        }
+    }
+    return trace;
+}
+
+Trace trace_load(const std::string &path) {
+    Trace         trace;
+    std::ifstream file(path);
+    std::string   line;
+
+    if (!file) {
+        ADD_FAILURE() << "Could not open trace " << path;
+        return trace;
+    }
+
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+
+        std::istringstream fields(line);
+        uint32_t           time;
+        unsigned           col, row;
+        char               direction;
+        if (!(fields >> time >> col >> row >> direction) || col >= MATRIX_COLS || row >= MATRIX_ROWS || (direction != 'd' && direction != 'u')) {
+            ADD_FAILURE() << "Invalid trace event in " << path << ": " << line;
+            continue;
+        }
+        trace.push_back({time, (uint8_t)col, (uint8_t)row, direction == 'd'});
+    }
+    return trace;
+}
+
+void BenchFixture::set_bench_keymap(layer_t layer_count, std::initializer_list<KeymapKey> keys) {
+    set_keymap(keys);
+    for (layer_t layer = 0; layer < layer_count; layer++) {
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                if (!find_key(layer, {.col = col, .row = row})) {
+                    add_key(KeymapKey(layer, col, row, layer == 0 ? KC_A + (row * MATRIX_COLS + col) % (KC_0 - KC_A) : KC_TRANSPARENT));
+                }
+            }
+        }
+    }
+}
+
+BenchResult BenchFixture::replay(const std::string &name, const Trace &trace, unsigned iterations) {
+    Trace events = trace;
+    std::stable_sort(events.begin(), events.end(), [](const TraceEvent &a, const TraceEvent &b) { return a.time < b.time; });
+
+    uint32_t       scans           = (events.empty() ? 0 : events.back().time) + BENCH_SETTLE_TIME;
+    host_driver_t *previous_driver = host_get_driver();
+    uint64_t       nanoseconds     = 0;
+
+    host_set_driver(&bench_driver);
+    bench_reports               = 0;
+    uint32_t allocations_before = bench_allocations;
+
+    for (unsigned i = 0; i < iterations; i++) {
+        auto next  = events.begin();
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t time = 0; time < scans; time++) {
+            for (; next != events.end() && next->time <= time; next++) {
+                if (next->pressed) {
+                    press_key(next->col, next->row);
+                } else {
+                    release_key(next->col, next->row);
+                }
+            }
+            run_one_scan_loop();
+        }
+        nanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    BenchResult result = {
+        .scans       = scans,
+        .ns_per_scan = iterations ? (double)nanoseconds / ((uint64_t)scans * iterations) : 0,
+        .allocations = iterations ? (bench_allocations - allocations_before) / iterations : 0,
+        .reports     = iterations ? bench_reports / iterations : 0,
+    };
+
+    host_set_driver(previous_driver);
+
+    printf("[ BENCH    ] %-32s %8.1f ns/scan %6u scans %4u allocs %4u reports\n", name.c_str(), result.ns_per_scan, result.scans, result.allocations, result.reports);
+    return result;
+}
+
+/* Replays a trace recorded on a real keyboard, e.g. QMK_BENCH_TRACE=typing.trace make bench:all */
+TEST_F(BenchFixture, RecordedTrace) {
+    const char *path = getenv("QMK_BENCH_TRACE");
+    if (!path) {
+        GTEST_SKIP() << "QMK_BENCH_TRACE is not set";
+    }
+
+    set_bench_keymap(1, {});
+    replay(path, trace_load(path));
+}
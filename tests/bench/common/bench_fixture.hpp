@@ -0,0 +1,67 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "test_common.hpp"
+
+#ifndef BENCH_ITERATIONS
+#    define BENCH_ITERATIONS 100
+#endif
+
+/* Scans run after the last event of a trace, so pending taps, combos and tap dances resolve. */
+#ifndef BENCH_SETTLE_TIME
+#    define BENCH_SETTLE_TIME (TAPPING_TERM * 2)
+#endif
+
+/* A single switch change, `time` is in ms (scans) relative to the start of the trace. */
+struct TraceEvent {
+    uint32_t time;
+    uint8_t  col;
+    uint8_t  row;
+    bool     pressed;
+};
+
+typedef std::vector<TraceEvent> Trace;
+
+/* Press `key` at `time` and release it `hold` ms later. */
+void trace_tap(Trace& trace, uint32_t time, const KeymapKey& key, uint16_t hold);
+/* Tap every key in order, each one pressed `interval` ms after the previous one and held for `hold` ms. */
+void trace_roll(Trace& trace, uint32_t time, std::initializer_list<KeymapKey> keys, uint16_t interval, uint16_t hold);
+/* Append `count` copies of `pattern`, starting `period` ms apart. */
+Trace trace_repeat(const Trace& pattern, unsigned count, uint32_t period);
+/* Read a recorded trace, one "<time> <col> <row> <d|u>" event per line. */
+Trace trace_load(const std::string& path);
+
+/* Cost of a single replay of a trace. */
+struct BenchResult {
+    uint32_t scans;
+    double   ns_per_scan;
+    uint32_t allocations;
+    uint32_t reports;
+};
+
+class BenchFixture : public TestFixture {
+   protected:
+    /* Map `keys`, and every other position of layers 0 to `layer_count - 1`, so any trace can be replayed. */
+    void set_bench_keymap(layer_t layer_count, std::initializer_list<KeymapKey> keys);
+
+    /* Replay `trace` through keyboard_task() `iterations` times and print the per-pass cost. */
+    BenchResult replay(const std::string& name, const Trace& trace, unsigned iterations = BENCH_ITERATIONS);
+};
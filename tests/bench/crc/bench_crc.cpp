@@ -0,0 +1,76 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#include "bench_fixture.hpp"
+
+extern "C" {
+#include "crc.h"
+}
+
+/* Bytes hashed for each measurement, enough to keep the clock resolution out of the numbers. */
+#ifndef BENCH_CRC_BYTES
+#    define BENCH_CRC_BYTES (1024 * 1024)
+#endif
+
+/* Bitwise CRC-32, what every CRC_ENABLE build used before the tables, as the baseline. */
+static uint32_t bitwise_crc32(const void* data, size_t data_len) {
+    const uint8_t* bytes = (const uint8_t*)data;
+    uint32_t       crc   = 0xFFFFFFFF;
+    while (data_len--) {
+        crc ^= *bytes++;
+        for (int i = 0; i < 8; i++) {
+            crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320 : crc >> 1;
+        }
+    }
+    return ~crc;
+}
+
+template <typename T>
+static double bench_crc(const char* name, T (*crc)(const void*, size_t), size_t length) {
+    std::vector<uint8_t> data(length);
+    for (size_t i = 0; i < length; i++) {
+        data[i] = i * 31 + 7;
+    }
+
+    size_t     passes = BENCH_CRC_BYTES / length;
+    volatile T sink   = 0;
+    auto       start  = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < passes; i++) {
+        sink = sink ^ crc(data.data(), length);
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+    double ns_per_byte = elapsed.count() / (passes * length);
+    printf("[ BENCH    ] %-24s %5zu bytes %8.2f ns/byte\n", name, length, ns_per_byte);
+    return ns_per_byte;
+}
+
+class Crc : public BenchFixture {};
+
+TEST_F(Crc, Throughput) {
+    /* Sizes of a split sync record, an RPC frame, and an EEPROM / firmware block. */
+    for (size_t length : {4, 32, 256, 4096}) {
+        bench_crc<uint8_t>("crc8", crc8, length);
+        bench_crc<uint16_t>("crc16", crc16, length);
+        double sliced  = bench_crc<uint32_t>("crc32", crc32, length);
+        double bitwise = bench_crc<uint32_t>("crc32 bitwise", bitwise_crc32, length);
+        EXPECT_LT(sliced, bitwise);
+    }
+}
@@ -0,0 +1,91 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+#include <cstdio>
+
+#include "bench_fixture.hpp"
+
+extern "C" {
+#include "rgb_matrix.h"
+
+typedef HSV (*reactive_splash_f)(HSV hsv, int16_t dx, int16_t dy, uint8_t dist, uint16_t tick);
+
+bool effect_runner_reactive_splash(uint8_t start, effect_params_t* params, reactive_splash_f effect_func);
+HSV  SPLASH_math(HSV hsv, int16_t dx, int16_t dy, uint8_t dist, uint16_t tick);
+bool MULTISPLASH(effect_params_t* params);
+}
+
+/* Frames rendered for each measurement, enough to keep the clock resolution out of the numbers. */
+#ifndef BENCH_SPLASH_FRAMES
+#    define BENCH_SPLASH_FRAMES 20000
+#endif
+
+/* Steady typing, a key every 150ms with the newest 50ms ago. At full speed, splashes fade out after about 500ms, so only the
+ * last four hits still show. */
+static void track_typing(uint8_t hits) {
+    g_last_hit_tracker.count = hits;
+    for (uint8_t i = 0; i < hits; i++) {
+        uint8_t led                 = (i * 7) % DRIVER_LED_TOTAL;
+        g_last_hit_tracker.x[i]     = g_led_config.point[led].x;
+        g_last_hit_tracker.y[i]     = g_led_config.point[led].y;
+        g_last_hit_tracker.index[i] = led;
+        g_last_hit_tracker.tick[i]  = 50 + (hits - 1 - i) * 150;
+    }
+}
+
+static void multisplash_unculled(effect_params_t* params) {
+    effect_runner_reactive_splash(0, params, &SPLASH_math);
+}
+
+static void multisplash_culled(effect_params_t* params) {
+    MULTISPLASH(params);
+}
+
+static double bench_frames(void (*render)(effect_params_t*)) {
+    effect_params_t params = {};
+    params.flags           = LED_FLAG_ALL;
+
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i < BENCH_SPLASH_FRAMES; i++) {
+        render(&params);
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / BENCH_SPLASH_FRAMES;
+}
+
+class RgbMatrixSplash : public BenchFixture {};
+
+TEST_F(RgbMatrixSplash, FrameCostByHits) {
+    rgb_matrix_config.hsv   = (HSV){0, 255, 255};
+    rgb_matrix_config.speed = 255;
+
+    double culled_showing = 0, unculled_showing = 0, culled_last = 0, unculled_last = 0;
+    for (uint8_t hits = 1; hits <= LED_HITS_TO_REMEMBER; hits *= 2) {
+        track_typing(hits);
+        culled_last   = bench_frames(multisplash_culled);
+        unculled_last = bench_frames(multisplash_unculled);
+        if (hits == 4) {
+            culled_showing   = culled_last;
+            unculled_showing = unculled_last;
+        }
+        printf("[ BENCH    ] multisplash %2u hits culled %10.1f ns/frame unculled %10.1f ns/frame\n", hits, culled_last, unculled_last);
+    }
+
+    // Hits that faded out cost next to nothing, so the culled frames stay about flat as they pile up behind the showing ones
+    EXPECT_LT(culled_last, unculled_last);
+    EXPECT_LT(culled_last / culled_showing, unculled_last / unculled_showing / 2);
+}
@@ -0,0 +1,53 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "bench_fixture.hpp"
+
+extern "C" {
+#include "tap_dance_actions.h"
+}
+
+class TapDance : public BenchFixture {
+   protected:
+    KeymapKey key_esc = KeymapKey(0, 0, 0, TD(TD_ESC_CAPS));
+    KeymapKey key_q   = KeymapKey(0, 1, 0, TD(TD_Q_W));
+    KeymapKey key_a   = KeymapKey(0, 0, 1, KC_A);
+
+    void SetUp() override {
+        set_bench_keymap(1, {key_esc, key_q, key_a});
+    }
+};
+
+TEST_F(TapDance, SingleAndDoubleTaps) {
+    Trace pattern;
+
+    trace_tap(pattern, 0, key_esc, 20);
+    trace_tap(pattern, TAPPING_TERM + 50, key_esc, 20);
+    trace_tap(pattern, TAPPING_TERM + 100, key_esc, 20);
+
+    auto result = replay("single and double taps", trace_repeat(pattern, 10, 2 * TAPPING_TERM + 200));
+    EXPECT_EQ(result.allocations, 0);
+}
+
+TEST_F(TapDance, InterruptedByTyping) {
+    Trace pattern;
+
+    /* A tap dance interrupted by another key, which has to be held back until the dance finishes. */
+    trace_roll(pattern, 0, {key_q, key_a, key_q, key_a}, 30, 20);
+
+    auto result = replay("interrupted by typing", trace_repeat(pattern, 20, 200));
+    EXPECT_EQ(result.allocations, 0);
+}
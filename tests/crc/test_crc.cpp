@@ -0,0 +1,127 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "crc.h"
+}
+
+static const char check_input[] = "123456789";
+
+// Plain bitwise reference implementations, straight from the parameters in crc.h
+static uint8_t reference_crc8(const std::vector<uint8_t>& data) {
+    uint8_t crc = 0xFF;
+    for (uint8_t byte : data) {
+        crc ^= byte;
+        for (int i = 0; i < 8; i++) {
+            crc = (crc & 0x80) ? (crc << 1) ^ 0x31 : crc << 1;
+        }
+    }
+    return crc;
+}
+
+static uint16_t reference_crc16(const std::vector<uint8_t>& data) {
+    uint16_t crc = 0xFFFF;
+    for (uint8_t byte : data) {
+        crc ^= byte << 8;
+        for (int i = 0; i < 8; i++) {
+            crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+        }
+    }
+    return crc;
+}
+
+static uint32_t reference_crc32(const std::vector<uint8_t>& data) {
+    uint32_t crc = 0xFFFFFFFF;
+    for (uint8_t byte : data) {
+        crc ^= byte;
+        for (int i = 0; i < 8; i++) {
+            crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320 : crc >> 1;
+        }
+    }
+    return ~crc;
+}
+
+static std::vector<uint8_t> test_data(size_t length) {
+    std::vector<uint8_t> data(length);
+    uint32_t             state = 0x12345678;
+    for (auto& byte : data) {
+        state = state * 1103515245 + 12345;
+        byte  = state >> 16;
+    }
+    return data;
+}
+
+class Crc : public TestFixture {};
+
+TEST_F(Crc, CheckValues) {
+    EXPECT_EQ(crc8(check_input, 9), 0xF7);
+    EXPECT_EQ(crc16(check_input, 9), 0x29B1);
+    EXPECT_EQ(crc32(check_input, 9), 0xCBF43926);
+}
+
+TEST_F(Crc, EmptyInput) {
+    EXPECT_EQ(crc8(check_input, 0), 0xFF);
+    EXPECT_EQ(crc16(check_input, 0), 0xFFFF);
+    EXPECT_EQ(crc32(check_input, 0), 0x00000000);
+}
+
+TEST_F(Crc, MatchesReference) {
+    // Odd lengths and offsets exercise the bytewise tail and unaligned starts of the sliced loop
+    for (size_t length : {1, 2, 3, 4, 5, 7, 8, 31, 32, 33, 255, 1024}) {
+        auto data = test_data(length + 3);
+        for (size_t offset = 0; offset < 4 && offset + length <= data.size(); offset++) {
+            std::vector<uint8_t> slice(data.begin() + offset, data.begin() + offset + length);
+            EXPECT_EQ(crc8(slice.data(), length), reference_crc8(slice)) << "length " << length << " offset " << offset;
+            EXPECT_EQ(crc16(slice.data(), length), reference_crc16(slice)) << "length " << length << " offset " << offset;
+            EXPECT_EQ(crc32(slice.data(), length), reference_crc32(slice)) << "length " << length << " offset " << offset;
+        }
+    }
+}
+
+TEST_F(Crc, IncrementalMatchesOneShot) {
+    auto data = test_data(67);
+    for (size_t split = 0; split <= data.size(); split++) {
+        uint8_t c8 = crc8_init();
+        c8         = crc8_update(c8, data.data(), split);
+        c8         = crc8_update(c8, data.data() + split, data.size() - split);
+        EXPECT_EQ(crc8_final(c8), crc8(data.data(), data.size())) << "split at " << split;
+
+        uint16_t c16 = crc16_init();
+        c16          = crc16_update(c16, data.data(), split);
+        c16          = crc16_update(c16, data.data() + split, data.size() - split);
+        EXPECT_EQ(crc16_final(c16), crc16(data.data(), data.size())) << "split at " << split;
+
+        uint32_t c32 = crc32_init();
+        c32          = crc32_update(c32, data.data(), split);
+        c32          = crc32_update(c32, data.data() + split, data.size() - split);
+        EXPECT_EQ(crc32_final(c32), crc32(data.data(), data.size())) << "split at " << split;
+    }
+}
+
+TEST_F(Crc, DetectsSingleBitErrors) {
+    auto data = test_data(32);
+    auto crc  = crc16(data.data(), data.size());
+    for (size_t bit = 0; bit < data.size() * 8; bit++) {
+        data[bit / 8] ^= 1 << (bit % 8);
+        EXPECT_NE(crc16(data.data(), data.size()), crc) << "bit " << bit;
+        data[bit / 8] ^= 1 << (bit % 8);
+    }
+}
@@ -0,0 +1,172 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+extern "C" {
+#include "input_latency.h"
+}
+
+using testing::_;
+using testing::InSequence;
+
+class InputLatency : public TestFixture {
+   protected:
+    void SetUp() override {
+        input_latency_clear();
+    }
+
+    uint16_t count(input_latency_stage_t stage, uint8_t bucket) {
+        return input_latency_get_histogram(stage)->buckets[bucket];
+    }
+
+    /* Timestamps are forced odd, so measurements can come out 1ms short. */
+    uint16_t count_about(input_latency_stage_t stage, uint8_t bucket) {
+        return count(stage, bucket - 1) + count(stage, bucket);
+    }
+};
+
+TEST_F(InputLatency, KeyPressedAndReleasedIsMeasuredInTheFirstBucket) {
+    TestDriver driver;
+    auto       key = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key});
+
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_A)));
+    key.press();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    key.release();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_EQ(count(INPUT_LATENCY_PROCESS, 0), 2);
+    EXPECT_EQ(count(INPUT_LATENCY_REPORT, 0), 2);
+    EXPECT_EQ(count(INPUT_LATENCY_SEND, 0), 2);
+    EXPECT_EQ(count(INPUT_LATENCY_TOTAL, 0), 2);
+}
+
+TEST_F(InputLatency, HoldDecidedAfterTappingTermIsMeasuredInTheLastBucket) {
+    TestDriver driver;
+    auto       mod_tap_key = KeymapKey(0, 0, 0, SFT_T(KC_P));
+
+    set_keymap({mod_tap_key});
+
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(0);
+    mod_tap_key.press();
+    idle_for(TAPPING_TERM);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_LSFT)));
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_EQ(count(INPUT_LATENCY_PROCESS, INPUT_LATENCY_BUCKETS - 1), 1);
+    EXPECT_EQ(count(INPUT_LATENCY_REPORT, 0), 1);
+    EXPECT_EQ(count(INPUT_LATENCY_TOTAL, INPUT_LATENCY_BUCKETS - 1), 1);
+
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    mod_tap_key.release();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(InputLatency, TotalStartsAtTheRawChange) {
+    TestDriver driver;
+    auto       key = KeymapKey(0, 1, 0, KC_A);
+
+    set_keymap({key});
+
+    // the switch closes, the key edge follows once debounce settled 4ms later
+    input_latency_raw_change(0, 0b10, 0b10);
+    wait_ms(4);
+
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_A)));
+    key.press();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_EQ(count_about(INPUT_LATENCY_DEBOUNCE, 4), 1);
+    EXPECT_EQ(count(INPUT_LATENCY_PROCESS, 0), 1);
+    EXPECT_EQ(count_about(INPUT_LATENCY_TOTAL, 4), 1);
+
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    key.release();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(InputLatency, BouncesKeepTheFirstEdgeOfEachKey) {
+    TestDriver driver;
+    auto       key = KeymapKey(0, 1, 0, KC_A);
+
+    set_keymap({key});
+
+    input_latency_raw_change(0, 0b10, 0b10);
+    wait_ms(1);
+    // changes of other keys on the row and bounces of the key itself don't restart it
+    input_latency_raw_change(0, 0b11, 0b01);
+    wait_ms(1);
+    input_latency_raw_change(0, 0b01, 0b10);
+    input_latency_raw_change(0, 0b11, 0b10);
+    wait_ms(2);
+
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_A)));
+    key.press();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_EQ(count_about(INPUT_LATENCY_DEBOUNCE, 4), 1);
+    EXPECT_EQ(count_about(INPUT_LATENCY_TOTAL, 4), 1);
+
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    key.release();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(InputLatency, GlitchIsNotMeasuredWithTheNextEdge) {
+    TestDriver driver;
+    auto       key = KeymapKey(0, 1, 0, KC_A);
+
+    set_keymap({key});
+
+    // a glitch that is filtered by debounce
+    input_latency_raw_change(0, 0b10, 0b10);
+    wait_ms(1);
+    input_latency_raw_change(0, 0b00, 0b10);
+    wait_ms(20);
+
+    input_latency_raw_change(0, 0b10, 0b10);
+    wait_ms(2);
+
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_A)));
+    key.press();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_EQ(count_about(INPUT_LATENCY_DEBOUNCE, 2), 1);
+    EXPECT_EQ(count_about(INPUT_LATENCY_TOTAL, 2), 1);
+
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    key.release();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
@@ -0,0 +1,115 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+class OpaqueLayerCache : public TestFixture {
+   protected:
+    /* The cache indexes whole layers, so every position of the used layers needs a keycode. */
+    void set_layers(layer_t layer_count, std::initializer_list<KeymapKey> keys) {
+        keymap.clear();
+        for (auto& key : keys) {
+            add_key(key);
+        }
+        for (layer_t layer = 0; layer < layer_count; layer++) {
+            for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+                for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                    if (!find_key(layer, {.col = col, .row = row})) {
+                        add_key(KeymapKey(layer, col, row, layer == 0 ? KC_NO : KC_TRANSPARENT));
+                    }
+                }
+            }
+        }
+        opaque_layer_cache_invalidate();
+    }
+};
+
+TEST_F(OpaqueLayerCache, TransparentKeyFallsThroughToLowerLayer) {
+    TestDriver driver;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+    auto       key_b = KeymapKey(1, 1, 0, KC_B);
+
+    set_layers(2, {key_a, key_b});
+
+    layer_on(1);
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 0);
+    EXPECT_EQ(layer_switch_get_layer(key_b.position), 1);
+
+    key_a.press();
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_A)));
+    run_one_scan_loop();
+
+    key_a.release();
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    run_one_scan_loop();
+
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(OpaqueLayerCache, HighestOpaqueActiveLayerWins) {
+    TestDriver driver;
+    auto       key_0 = KeymapKey(0, 0, 0, KC_A);
+    auto       key_1 = KeymapKey(1, 0, 0, KC_B);
+    auto       key_2 = KeymapKey(2, 0, 0, KC_C);
+
+    set_layers(4, {key_0, key_1, key_2});
+
+    EXPECT_EQ(layer_switch_get_layer(key_0.position), 0);
+
+    layer_on(1);
+    EXPECT_EQ(layer_switch_get_layer(key_0.position), 1);
+
+    layer_on(3);
+    EXPECT_EQ(layer_switch_get_layer(key_0.position), 1);
+
+    layer_on(2);
+    EXPECT_EQ(layer_switch_get_layer(key_0.position), 2);
+
+    layer_off(2);
+    layer_off(1);
+    EXPECT_EQ(layer_switch_get_layer(key_0.position), 0);
+
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(OpaqueLayerCache, InvalidateReindexesChangedKeymap) {
+    TestDriver driver;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+    auto       key_b = KeymapKey(1, 0, 0, KC_B);
+
+    set_layers(2, {key_a});
+
+    layer_on(1);
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 0);
+
+    set_layers(2, {key_a, key_b});
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 1);
+
+    key_b.press();
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_B)));
+    run_one_scan_loop();
+
+    key_b.release();
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport()));
+    run_one_scan_loop();
+
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
@@ -0,0 +1,62 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "rgb_matrix_test_driver.h"
+
+RGB rgb_matrix_test_leds[DRIVER_LED_TOTAL];
+
+/* One LED per key of the test matrix, laid out on a 22x16 grid, with the first column as modifiers. */
+// clang-format off
+led_config_t g_led_config = {
+    {
+        {  0,  1,  2,  3,  4,  5,  6,  7,  8,  9 },
+        { 10, 11, 12, 13, 14, 15, 16, 17, 18, 19 },
+        { 20, 21, 22, 23, 24, 25, 26, 27, 28, 29 },
+        { 30, 31, 32, 33, 34, 35, 36, 37, 38, 39 }
+    }, {
+        {   0,  0 }, {  22,  0 }, {  44,  0 }, {  66,  0 }, {  88,  0 }, { 110,  0 }, { 132,  0 }, { 154,  0 }, { 176,  0 }, { 198,  0 },
+        {   0, 21 }, {  22, 21 }, {  44, 21 }, {  66, 21 }, {  88, 21 }, { 110, 21 }, { 132, 21 }, { 154, 21 }, { 176, 21 }, { 198, 21 },
+        {   0, 42 }, {  22, 42 }, {  44, 42 }, {  66, 42 }, {  88, 42 }, { 110, 42 }, { 132, 42 }, { 154, 42 }, { 176, 42 }, { 198, 42 },
+        {   0, 64 }, {  22, 64 }, {  44, 64 }, {  66, 64 }, {  88, 64 }, { 110, 64 }, { 132, 64 }, { 154, 64 }, { 176, 64 }, { 198, 64 }
+    }, {
+        1, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+        1, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+        1, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+        1, 4, 4, 4, 4, 4, 4, 4, 4, 4
+    }
+};
+// clang-format on
+
+static void test_init(void) {}
+
+static void test_set_color(int index, uint8_t r, uint8_t g, uint8_t b) {
+    rgb_matrix_test_leds[index] = (RGB){.r = r, .g = g, .b = b};
+}
+
+static void test_set_color_all(uint8_t r, uint8_t g, uint8_t b) {
+    for (uint8_t i = 0; i < DRIVER_LED_TOTAL; i++) {
+        test_set_color(i, r, g, b);
+    }
+}
+
+static void test_flush(void) {}
+
+const rgb_matrix_driver_t rgb_matrix_driver = {
+    .init          = test_init,
+    .set_color     = test_set_color,
+    .set_color_all = test_set_color_all,
+    .flush         = test_flush,
+};
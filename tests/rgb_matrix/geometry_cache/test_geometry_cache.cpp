@@ -0,0 +1,153 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "rgb_matrix.h"
+#include "rgb_matrix_test_driver.h"
+#include "lib/lib8tion/lib8tion.h"
+
+extern const led_point_t k_rgb_matrix_center;
+
+bool CYCLE_OUT_IN(effect_params_t* params);
+bool CYCLE_OUT_IN_DUAL(effect_params_t* params);
+bool CYCLE_PINWHEEL(effect_params_t* params);
+bool CYCLE_SPIRAL(effect_params_t* params);
+bool BAND_PINWHEEL_SAT(effect_params_t* params);
+bool BAND_PINWHEEL_VAL(effect_params_t* params);
+bool BAND_SPIRAL_SAT(effect_params_t* params);
+bool BAND_SPIRAL_VAL(effect_params_t* params);
+
+/* Leave the colors in HSV, so that every component is compared as the effect worked it out. */
+RGB rgb_matrix_hsv_to_rgb(HSV hsv) {
+    RGB rgb;
+    rgb.r = hsv.h;
+    rgb.g = hsv.s;
+    rgb.b = hsv.v;
+    return rgb;
+}
+}
+
+/* The effects' math from before the geometry cache, working out the distance and angle of each LED itself. */
+typedef HSV (*live_math_f)(HSV hsv, int16_t dx, int16_t dy, uint8_t time);
+
+static HSV CYCLE_OUT_IN_live(HSV hsv, int16_t dx, int16_t dy, uint8_t time) {
+    uint8_t dist = sqrt16(dx * dx + dy * dy);
+    hsv.h        = 3 * dist / 2 + time;
+    return hsv;
+}
+
+static HSV CYCLE_OUT_IN_DUAL_live(HSV hsv, int16_t dx, int16_t dy, uint8_t time) {
+    dx           = (k_rgb_matrix_center.x / 2) - abs8(dx);
+    uint8_t dist = sqrt16(dx * dx + dy * dy);
+    hsv.h        = 3 * dist + time;
+    return hsv;
+}
+
+static HSV CYCLE_PINWHEEL_live(HSV hsv, int16_t dx, int16_t dy, uint8_t time) {
+    hsv.h = atan2_8(dy, dx) + time;
+    return hsv;
+}
+
+static HSV CYCLE_SPIRAL_live(HSV hsv, int16_t dx, int16_t dy, uint8_t time) {
+    uint8_t dist = sqrt16(dx * dx + dy * dy);
+    hsv.h        = dist - time - atan2_8(dy, dx);
+    return hsv;
+}
+
+static HSV BAND_PINWHEEL_SAT_live(HSV hsv, int16_t dx, int16_t dy, uint8_t time) {
+    hsv.s = scale8(hsv.s - time - atan2_8(dy, dx) * 3, hsv.s);
+    return hsv;
+}
+
+static HSV BAND_PINWHEEL_VAL_live(HSV hsv, int16_t dx, int16_t dy, uint8_t time) {
+    hsv.v = scale8(hsv.v - time - atan2_8(dy, dx) * 3, hsv.v);
+    return hsv;
+}
+
+static HSV BAND_SPIRAL_SAT_live(HSV hsv, int16_t dx, int16_t dy, uint8_t time) {
+    uint8_t dist = sqrt16(dx * dx + dy * dy);
+    hsv.s        = scale8(hsv.s + dist - time - atan2_8(dy, dx), hsv.s);
+    return hsv;
+}
+
+static HSV BAND_SPIRAL_VAL_live(HSV hsv, int16_t dx, int16_t dy, uint8_t time) {
+    uint8_t dist = sqrt16(dx * dx + dy * dy);
+    hsv.v        = scale8(hsv.v + dist - time - atan2_8(dy, dx), hsv.v);
+    return hsv;
+}
+
+class GeometryCache : public TestFixture {
+   protected:
+    void SetUp() override {
+        rgb_matrix_config.hsv   = (HSV){40, 200, 230};
+        rgb_matrix_config.speed = 127;
+    }
+
+    void expect_same_render(bool (*effect)(effect_params_t*), live_math_f live_math) {
+        for (uint32_t timer = 0; timer < 20000; timer += 97) {
+            g_rgb_timer            = timer;
+            effect_params_t params = {};
+            params.flags           = LED_FLAG_ALL;
+            effect(&params);
+
+            uint8_t time = scale16by8(g_rgb_timer, rgb_matrix_config.speed / 2);
+            for (uint8_t i = 0; i < DRIVER_LED_TOTAL; i++) {
+                SCOPED_TRACE(testing::Message() << "at " << timer << "ms, LED " << (int)i);
+                int16_t dx  = g_led_config.point[i].x - k_rgb_matrix_center.x;
+                int16_t dy  = g_led_config.point[i].y - k_rgb_matrix_center.y;
+                HSV     hsv = live_math(rgb_matrix_config.hsv, dx, dy, time);
+                ASSERT_EQ(rgb_matrix_test_leds[i].r, hsv.h) << "hue";
+                ASSERT_EQ(rgb_matrix_test_leds[i].g, hsv.s) << "saturation";
+                ASSERT_EQ(rgb_matrix_test_leds[i].b, hsv.v) << "value";
+            }
+        }
+    }
+};
+
+TEST_F(GeometryCache, CacheMatchesLiveGeometry) {
+    for (uint8_t i = 0; i < DRIVER_LED_TOTAL; i++) {
+        SCOPED_TRACE(testing::Message() << "LED " << (int)i);
+        int16_t dx = g_led_config.point[i].x - k_rgb_matrix_center.x;
+        int16_t dy = g_led_config.point[i].y - k_rgb_matrix_center.y;
+        EXPECT_EQ(g_led_geometry[i].dx, dx);
+        EXPECT_EQ(g_led_geometry[i].dy, dy);
+        EXPECT_EQ(g_led_geometry[i].dist, sqrt16(dx * dx + dy * dy));
+        EXPECT_EQ(g_led_geometry[i].angle, atan2_8(dy, dx));
+    }
+}
+
+TEST_F(GeometryCache, DistanceRunnerIsUnchanged) {
+    expect_same_render(CYCLE_OUT_IN, CYCLE_OUT_IN_live);
+}
+
+TEST_F(GeometryCache, OffsetRunnerIsUnchanged) {
+    expect_same_render(CYCLE_OUT_IN_DUAL, CYCLE_OUT_IN_DUAL_live);
+}
+
+TEST_F(GeometryCache, AngleRunnerIsUnchanged) {
+    expect_same_render(CYCLE_PINWHEEL, CYCLE_PINWHEEL_live);
+    expect_same_render(BAND_PINWHEEL_SAT, BAND_PINWHEEL_SAT_live);
+    expect_same_render(BAND_PINWHEEL_VAL, BAND_PINWHEEL_VAL_live);
+}
+
+TEST_F(GeometryCache, PolarRunnerIsUnchanged) {
+    expect_same_render(CYCLE_SPIRAL, CYCLE_SPIRAL_live);
+    expect_same_render(BAND_SPIRAL_SAT, BAND_SPIRAL_SAT_live);
+    expect_same_render(BAND_SPIRAL_VAL, BAND_SPIRAL_VAL_live);
+}
@@ -0,0 +1,156 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include "test_common.hpp"
+#include <vector>
+
+extern "C" {
+#include "rgb_matrix.h"
+#include "rgb_matrix_test_driver.h"
+#include "lib/lib8tion/lib8tion.h"
+
+typedef HSV (*reactive_splash_f)(HSV hsv, int16_t dx, int16_t dy, uint8_t dist, uint16_t tick);
+typedef bool (*reactive_splash_range_f)(uint16_t tick, uint8_t* inner, uint8_t* outer);
+
+bool effect_runner_reactive_splash(uint8_t start, effect_params_t* params, reactive_splash_f effect_func);
+bool effect_runner_reactive_splash_culled(uint8_t start, effect_params_t* params, reactive_splash_f effect_func, reactive_splash_range_f range_func);
+
+bool SPLASH(effect_params_t* params);
+bool MULTISPLASH(effect_params_t* params);
+bool SOLID_REACTIVE_NEXUS(effect_params_t* params);
+bool SOLID_REACTIVE_MULTINEXUS(effect_params_t* params);
+
+/* Leave the colors in HSV, so that the hue of dark LEDs can be told apart from a wrong value. */
+RGB rgb_matrix_hsv_to_rgb(HSV hsv) {
+    RGB rgb;
+    rgb.r = hsv.h;
+    rgb.g = hsv.s;
+    rgb.b = hsv.v;
+    return rgb;
+}
+}
+
+/* The effects' own math, to render them with the runner that evaluates every hit at every LED. */
+namespace unculled {
+#define RGB_MATRIX_EFFECT(name)
+#define RGB_MATRIX_CUSTOM_EFFECT_IMPLS
+#include "animations/splash_anim.h"
+#include "animations/solid_reactive_nexus.h"
+#undef RGB_MATRIX_CUSTOM_EFFECT_IMPLS
+#undef RGB_MATRIX_EFFECT
+} // namespace unculled
+
+/* A burst of typing across the board, time in ms and the LED hit, including the corners of the grid. */
+struct recorded_hit_t {
+    uint16_t time;
+    uint8_t  led;
+};
+
+static const std::vector<recorded_hit_t> recorded_hits = {
+    {0, 0},     {90, 11},   {170, 22},  {260, 39},  {300, 33},  {380, 14},  {420, 15},  {430, 16},  {520, 9},   {610, 30},
+    {700, 25},  {705, 24},  {790, 18},  {900, 1},   {1200, 38}, {1260, 20}, {1330, 5},  {1390, 27}, {1900, 12}, {2600, 35},
+};
+
+/* Play the recorded hits up to time, as rgb_matrix would have tracked them. */
+static void track_hits_until(uint16_t time) {
+    g_last_hit_tracker.count = 0;
+    for (auto& hit : recorded_hits) {
+        if (hit.time > time) break;
+        if (g_last_hit_tracker.count == LED_HITS_TO_REMEMBER) {
+            memmove(&g_last_hit_tracker.x[0], &g_last_hit_tracker.x[1], LED_HITS_TO_REMEMBER - 1);
+            memmove(&g_last_hit_tracker.y[0], &g_last_hit_tracker.y[1], LED_HITS_TO_REMEMBER - 1);
+            memmove(&g_last_hit_tracker.index[0], &g_last_hit_tracker.index[1], LED_HITS_TO_REMEMBER - 1);
+            memmove(&g_last_hit_tracker.tick[0], &g_last_hit_tracker.tick[1], (LED_HITS_TO_REMEMBER - 1) * sizeof(uint16_t));
+            g_last_hit_tracker.count--;
+        }
+        uint8_t i                     = g_last_hit_tracker.count++;
+        g_last_hit_tracker.x[i]       = g_led_config.point[hit.led].x;
+        g_last_hit_tracker.y[i]       = g_led_config.point[hit.led].y;
+        g_last_hit_tracker.index[i]   = hit.led;
+        g_last_hit_tracker.tick[i]    = time - hit.time;
+    }
+}
+
+class ReactiveSplash : public TestFixture {
+   protected:
+    void SetUp() override {
+        rgb_matrix_config.hsv   = (HSV){40, 200, 255};
+        rgb_matrix_config.speed = 127;
+        rgb_matrix_config.flags = LED_FLAG_ALL;
+    }
+
+    std::vector<RGB> render(bool (*effect)(effect_params_t*)) {
+        effect_params_t params = {};
+        params.flags           = LED_FLAG_ALL;
+        memset(rgb_matrix_test_leds, 0xAA, sizeof(rgb_matrix_test_leds));
+        effect(&params);
+        return std::vector<RGB>(rgb_matrix_test_leds, rgb_matrix_test_leds + DRIVER_LED_TOTAL);
+    }
+
+    std::vector<RGB> render_unculled(uint8_t start, reactive_splash_f effect_func) {
+        effect_params_t params = {};
+        params.flags           = LED_FLAG_ALL;
+        memset(rgb_matrix_test_leds, 0x55, sizeof(rgb_matrix_test_leds));
+        effect_runner_reactive_splash(start, &params, effect_func);
+        return std::vector<RGB>(rgb_matrix_test_leds, rgb_matrix_test_leds + DRIVER_LED_TOTAL);
+    }
+
+    /* Compare every frame of the recording, hue_shifts allows the hue to be ahead by one step per culled hit. */
+    void expect_same_frames(bool (*effect)(effect_params_t*), bool multi, reactive_splash_f effect_func, bool hue_shifts) {
+        unsigned lit = 0;
+        for (uint16_t time = 0; time < 4000; time += 10) {
+            track_hits_until(time);
+            uint8_t start = multi ? 0 : qsub8(g_last_hit_tracker.count, 1);
+
+            auto culled   = render(effect);
+            auto unculled = render_unculled(start, effect_func);
+            for (uint8_t i = 0; i < DRIVER_LED_TOTAL; i++) {
+                SCOPED_TRACE(testing::Message() << "at " << time << "ms, LED " << (int)i);
+                ASSERT_EQ(culled[i].b, unculled[i].b) << "value";
+                ASSERT_EQ(culled[i].g, unculled[i].g) << "saturation";
+                // The hue of an unlit LED doesn't show
+                if (culled[i].b == 0) continue;
+                lit++;
+                if (hue_shifts) {
+                    // SPLASH nudged the hue back one step for every faded hit it evaluated
+                    uint8_t shift = culled[i].r - unculled[i].r;
+                    ASSERT_LE(shift, g_last_hit_tracker.count - start) << "hue";
+                } else {
+                    ASSERT_EQ(culled[i].r, unculled[i].r) << "hue";
+                }
+            }
+        }
+        // The recording is only useful if the splashes reach a good share of the frames
+        EXPECT_GT(lit, 400 * DRIVER_LED_TOTAL / 10);
+    }
+};
+
+TEST_F(ReactiveSplash, SplashMatchesUnculled) {
+    expect_same_frames(SPLASH, false, unculled::SPLASH_math, true);
+}
+
+TEST_F(ReactiveSplash, MultisplashMatchesUnculled) {
+    expect_same_frames(MULTISPLASH, true, unculled::SPLASH_math, true);
+}
+
+TEST_F(ReactiveSplash, NexusMatchesUnculled) {
+    expect_same_frames(SOLID_REACTIVE_NEXUS, false, unculled::SOLID_REACTIVE_NEXUS_math, false);
+}
+
+TEST_F(ReactiveSplash, MultinexusMatchesUnculled) {
+    expect_same_frames(SOLID_REACTIVE_MULTINEXUS, true, unculled::SOLID_REACTIVE_NEXUS_math, false);
+}
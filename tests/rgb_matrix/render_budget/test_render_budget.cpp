@@ -0,0 +1,151 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include "test_common.hpp"
+#include <vector>
+
+extern "C" {
+#include "rgb_matrix.h"
+}
+
+/* The render clock is stubbed, each effect costs the set time per LED rendered. */
+static uint64_t render_clock_ns;
+static uint32_t render_led_cost_ns[RGB_MATRIX_EFFECT_MAX];
+static unsigned render_frames_done;
+
+struct render_call_t {
+    uint8_t led_min;
+    uint8_t led_max;
+};
+static std::vector<render_call_t> render_calls;
+
+extern "C" uint32_t rgb_matrix_render_clock_us(void) {
+    return render_clock_ns / 1000;
+}
+
+extern "C" void rgb_matrix_indicators_advanced_user(uint8_t led_min, uint8_t led_max) {
+    render_clock_ns += (uint64_t)render_led_cost_ns[rgb_matrix_get_mode()] * (led_max - led_min);
+    render_calls.push_back({led_min, led_max});
+    if (led_max == DRIVER_LED_TOTAL) {
+        render_frames_done++;
+    }
+}
+
+class RenderBudget : public TestFixture {
+   protected:
+    TestDriver driver;
+
+    void SetUp() override {
+        // Render nothing for a while, so that the next effect is measured afresh
+        rgb_matrix_disable_noeeprom();
+        idle_for(2 * RGB_MATRIX_LED_FLUSH_LIMIT);
+        rgb_matrix_enable_noeeprom();
+    }
+
+    void start(uint8_t mode, uint32_t led_cost_ns) {
+        render_led_cost_ns[mode] = led_cost_ns;
+        rgb_matrix_mode_noeeprom(mode);
+    }
+
+    void render_frames(unsigned frames) {
+        unsigned target = render_frames_done + frames;
+        for (unsigned i = 0; render_frames_done < target; i++) {
+            ASSERT_LT(i, frames * 100 * RGB_MATRIX_LED_FLUSH_LIMIT) << "frames are not being rendered";
+            run_one_scan_loop();
+        }
+    }
+
+    uint8_t chunk() {
+        return rgb_matrix_get_render_stats()->chunk;
+    }
+};
+
+TEST_F(RenderBudget, ChunkFitsTheBudget) {
+    start(RGB_MATRIX_SOLID_COLOR, 10000);
+    render_frames(1);
+    EXPECT_EQ(chunk(), RGB_MATRIX_RENDER_BUDGET_US / 10);
+
+    // The next frame is rendered in calls of that size
+    render_calls.clear();
+    render_frames(1);
+    ASSERT_EQ(render_calls.size(), 2);
+    EXPECT_EQ(render_calls[0].led_min, 0);
+    EXPECT_EQ(render_calls[0].led_max, 20);
+    EXPECT_EQ(render_calls[1].led_min, 20);
+    EXPECT_EQ(render_calls[1].led_max, DRIVER_LED_TOTAL);
+}
+
+TEST_F(RenderBudget, ChunkConvergesWhenTheCostChanges) {
+    start(RGB_MATRIX_SOLID_COLOR, 10000);
+    render_frames(1);
+    ASSERT_EQ(chunk(), 20);
+
+    // The cost is averaged over frames of the same effect
+    render_led_cost_ns[RGB_MATRIX_SOLID_COLOR] = 20000;
+    render_frames(1);
+    EXPECT_GT(chunk(), 10);
+    EXPECT_LT(chunk(), 20);
+
+    render_frames(32);
+    EXPECT_EQ(chunk(), 10);
+    EXPECT_NEAR(rgb_matrix_get_render_stats()->led_cost_ns, 20000, 200);
+}
+
+TEST_F(RenderBudget, ChunkIsAtLeastOneLed) {
+    start(RGB_MATRIX_SOLID_COLOR, 1000000);
+    render_frames(1);
+    EXPECT_EQ(chunk(), 1);
+
+    render_calls.clear();
+    render_frames(1);
+    EXPECT_EQ(render_calls.size(), DRIVER_LED_TOTAL);
+}
+
+TEST_F(RenderBudget, ChunkIsAtMostAllLeds) {
+    start(RGB_MATRIX_SOLID_COLOR, 100);
+    render_frames(1);
+    EXPECT_EQ(chunk(), DRIVER_LED_TOTAL);
+
+    render_calls.clear();
+    render_frames(1);
+    ASSERT_EQ(render_calls.size(), 1);
+    EXPECT_EQ(render_calls[0].led_min, 0);
+    EXPECT_EQ(render_calls[0].led_max, DRIVER_LED_TOTAL);
+}
+
+TEST_F(RenderBudget, NewEffectIsMeasuredAfresh) {
+    start(RGB_MATRIX_SOLID_COLOR, 10000);
+    render_frames(8);
+    ASSERT_EQ(chunk(), 20);
+
+    // Averaged with the previous effect, the chunk would only drop to 14
+    start(RGB_MATRIX_ALPHAS_MODS, 40000);
+    render_frames(1);
+    EXPECT_EQ(chunk(), 5);
+    EXPECT_EQ(rgb_matrix_get_render_stats()->led_cost_ns, 40000);
+}
+
+TEST_F(RenderBudget, OverrunsAreCounted) {
+    start(RGB_MATRIX_SOLID_COLOR, 100);
+    render_frames(2);
+    uint32_t overruns = rgb_matrix_get_render_stats()->overruns;
+
+    // The chunk is sized from the cheap frames, so the first expensive one overruns
+    render_led_cost_ns[RGB_MATRIX_SOLID_COLOR] = 10000;
+    render_frames(1);
+    EXPECT_EQ(rgb_matrix_get_render_stats()->overruns, overruns + 1);
+}
@@ -0,0 +1,98 @@
+/* Copyright 2022 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+#include "test_common.hpp"
+#include <vector>
+
+extern "C" {
+#include "rgb_matrix.h"
+}
+
+static const uint8_t split_leds[2] = RGB_MATRIX_SPLIT;
+static bool          left_half     = true;
+
+/* Every LED costs 50us to render, so that a half takes several calls. */
+static uint64_t render_clock_ns;
+static unsigned render_frames_done;
+
+struct render_call_t {
+    uint8_t led_min;
+    uint8_t led_max;
+};
+static std::vector<render_call_t> render_calls;
+
+extern "C" bool is_keyboard_left(void) {
+    return left_half;
+}
+
+extern "C" uint32_t rgb_matrix_render_clock_us(void) {
+    return render_clock_ns / 1000;
+}
+
+extern "C" void rgb_matrix_indicators_advanced_user(uint8_t led_min, uint8_t led_max) {
+    render_clock_ns += 50000 * (led_max - led_min);
+    render_calls.push_back({led_min, led_max});
+    if (led_max == (left_half ? split_leds[0] : DRIVER_LED_TOTAL)) {
+        render_frames_done++;
+    }
+}
+
+class RenderBudgetSplit : public TestFixture {
+   protected:
+    TestDriver driver;
+
+    void render_half(bool left) {
+        left_half = left;
+        rgb_matrix_mode_noeeprom(RGB_MATRIX_SOLID_COLOR);
+
+        // The first frame sizes the chunk, the second is checked
+        render_frames(1);
+        render_calls.clear();
+        render_frames(1);
+        ASSERT_EQ(rgb_matrix_get_render_stats()->chunk, RGB_MATRIX_RENDER_BUDGET_US / 50);
+    }
+
+    void render_frames(unsigned frames) {
+        unsigned target = render_frames_done + frames;
+        for (unsigned i = 0; render_frames_done < target; i++) {
+            ASSERT_LT(i, frames * 100 * RGB_MATRIX_LED_FLUSH_LIMIT) << "frames are not being rendered";
+            run_one_scan_loop();
+        }
+    }
+
+    void expect_calls_cover(uint8_t first, uint8_t last) {
+        ASSERT_FALSE(render_calls.empty());
+        uint8_t next = first;
+        for (auto &call : render_calls) {
+            EXPECT_EQ(call.led_min, next);
+            EXPECT_GT(call.led_max, call.led_min);
+            EXPECT_LE(call.led_max, last);
+            next = call.led_max;
+        }
+        EXPECT_EQ(next, last);
+    }
+};
+
+TEST_F(RenderBudgetSplit, LeftHalfOnlyRendersItsLeds) {
+    render_half(true);
+    expect_calls_cover(0, split_leds[0]);
+}
+
+TEST_F(RenderBudgetSplit, RightHalfOnlyRendersItsLeds) {
+    render_half(false);
+    expect_calls_cover(split_leds[0], DRIVER_LED_TOTAL);
+}
@@ -23,6 +23,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "util.h"
 #include "debug.h"
 #include "digitizer.h"
+#ifdef INPUT_LATENCY_ENABLE
+#    include "input_latency.h"
+#endif
 
 #ifdef NKRO_ENABLE
 #    include "keycode_config.h"
@@ -78,7 +81,13 @@ void host_keyboard_send(report_keyboard_t *report) {
         report->report_id = REPORT_ID_KEYBOARD;
 #endif
     }
+#ifdef INPUT_LATENCY_ENABLE
+    input_latency_send_begin();
+#endif
     (*driver->send_keyboard)(report);
+#ifdef INPUT_LATENCY_ENABLE
+    input_latency_send_end();
+#endif
 
     if (debug_keyboard) {
         dprint("keyboard_report: ");